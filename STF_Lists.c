@@ -25,403 +25,1513 @@
 
 #include "STF_Lists.h"
 
-/*----------------######################################################################----------------*/
-/*----------------#--***** -- **** -- **** --**    ----**    --******--******--******--#----------------*/
-/*----------------#--******--******--******--**    ----**    --******--******--******--#----------------*/
-/*----------------#--**  **--**  **--**  **--**    ----**    --  **  --**    --  **  --#----------------*/
-/*----------------#--******--**  **--**  **--**    ----**    --  **  --******--  **  --#----------------*/
-/*----------------#--******--**  **--**  **--**    ----**    --  **  --******--  **  --#----------------*/
-/*----------------#--**  **--**  **--**  **--**    ----**    --  **  --    **--  **  --#----------------*/
-/*----------------#--******--******--******--******----******--******--******--  **  --#----------------*/
-/*----------------#--***** -- **** -- **** --******----******--******--******--  **  --#----------------*/
-/*----------------######################################################################----------------*/
-
-static BN * BN_create(bool v) {
-  BN *boolNode = (BN *)malloc(sizeof(BN));
-  if(boolNode == NULL) {
-    return NULL;
+// lists shorter than this are sorted by comparison instead of counting or radix sort
+#define STF_SORT_CUTOFF 64
+
+// the body of _XL_scan for nodes of type N: without a node table the list is
+// walked, with one the nodes are read four at a time since their loads don't
+// wait on each other like a walk over next does
+#define STF_SCAN(N, list, v, isCounted) do { \
+  int n = 0, i = 0; \
+  if(!(list)->isIndexed) { \
+    N *tmpNode = (list)->start; \
+    for(;i < (list)->size;i++) { \
+      if(tmpNode->value == (v)) { \
+        if(!(isCounted)) { \
+          return i; \
+        } \
+        n++; \
+      } \
+      tmpNode = tmpNode->next; \
+    } \
+    return (isCounted) ? n : -1; \
+  } \
+  N **nodes = (list)->nodes + (list)->offset; \
+  int n1 = 0, n2 = 0, n3 = 0; \
+  for(;i + 4 <= (list)->size;i += 4) { \
+    bool isEqual = nodes[i]->value == (v), isEqual1 = nodes[i + 1]->value == (v), \
+      isEqual2 = nodes[i + 2]->value == (v), isEqual3 = nodes[i + 3]->value == (v); \
+    if(isCounted) { \
+      n += isEqual; \
+      n1 += isEqual1; \
+      n2 += isEqual2; \
+      n3 += isEqual3; \
+    }else if(isEqual | isEqual1 | isEqual2 | isEqual3) { \
+      break; \
+    } \
+  } \
+  for(;i < (list)->size;i++) { \
+    if(nodes[i]->value == (v)) { \
+      if(!(isCounted)) { \
+        return i; \
+      } \
+      n++; \
+    } \
+  } \
+  return (isCounted) ? n + n1 + n2 + n3 : -1; \
+} while(0)
+
+static void * _STF_stdAlloc(void *context, size_t size) {
+  (void)context;
+  return malloc(size);
+}
+
+static void * _STF_stdRealloc(void *context, void *memory, size_t size) {
+  (void)context;
+  return realloc(memory, size);
+}
+
+static void _STF_stdFree(void *context, void *memory) {
+  (void)context;
+  free(memory);
+}
+
+// every allocation goes through this allocator unless the list was made with its own
+static STF_Allocator STF_allocator = {_STF_stdAlloc, _STF_stdRealloc, _STF_stdFree, NULL};
+// the number of blocks the library holds from STF_allocator, the arrays and
+// strings handed to the caller aren't counted since plain free may release them
+static long STF_liveAllocations = 0;
+
+bool STF_setAllocator(const STF_Allocator *allocator) {
+  STF_Allocator newAllocator = {_STF_stdAlloc, _STF_stdRealloc, _STF_stdFree, NULL};
+  if(allocator != NULL) {
+    newAllocator = *allocator;
+  }
+  bool isSame = newAllocator.alloc == STF_allocator.alloc && newAllocator.realloc == STF_allocator.realloc &&
+    newAllocator.free == STF_allocator.free && newAllocator.context == STF_allocator.context;
+  // the live blocks would be given back to an allocator they don't come from
+  if(!isSame && STF_liveAllocations != 0) {
+    return false;
   }
-  boolNode->value = v;
-  boolNode->next = NULL;
-  return boolNode;
+  STF_allocator = newAllocator;
+  return true;
 }
 
-static BN * BL_getNode(BL *list, int index) {
-  if(index < 0 || index >= list->size) {
-    return NULL;
-  }
-  BN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i == index) {
-      return tmpNode;
-    }
-    tmpNode = tmpNode->next;
+static void * STF_malloc(size_t size) {
+  void *memory = STF_allocator.alloc(STF_allocator.context, size);
+  if(memory != NULL) {
+    STF_liveAllocations++;
   }
+  return memory;
 }
 
-static void _BL_sort(BL *list, bool isReversed) {
-  BN *currentNode, *previousNode;
-  bool difference;
-  loopAgain:
-    difference = false;
-    currentNode = previousNode = list->start;
-    for(int i = 0;i < list->size;i++) {
-      currentNode = currentNode->next;
-      if(currentNode != NULL && (isReversed ? previousNode->value < currentNode->value :
-          previousNode->value > currentNode->value)) {
-        bool v = currentNode->value;
-        currentNode->value = previousNode->value;
-        previousNode->value = v;
-        difference = true;
-      }
-      previousNode = currentNode;
-    }
-  if(difference) {
-    goto loopAgain;
+static void * STF_calloc(size_t count, size_t size) {
+  void *memory = STF_malloc(count * size);
+  if(memory != NULL) {
+    memset(memory, 0, count * size);
   }
+  return memory;
 }
 
-BL * BL_create() {
-  BL *list = (BL *)malloc(sizeof(BL));
-  if(list == NULL) {
-    return NULL;
+static void * STF_realloc(void *memory, size_t size) {
+  void *newMemory = STF_allocator.realloc(STF_allocator.context, memory, size);
+  if(memory == NULL && newMemory != NULL) {
+    STF_liveAllocations++;
   }
-  list->start = list->end = NULL;
-  list->size = 0;
-  return list;
+  return newMemory;
 }
 
-bool BL_add(BL *list, bool v) {
-  BN *boolNode = BN_create(v);
-  if(boolNode == NULL) {
-    return false;
-  }
-  if(list->size == 0) {
-    list->start = list->end = boolNode;
-  }else if(list->size == 1) {
-    list->start->next = list->end = boolNode;
-  }else {
-    list->end->next = boolNode;
-    list->end = list->end->next;
+static void STF_release(void *memory) {
+  if(memory != NULL) {
+    STF_liveAllocations--;
+    STF_allocator.free(STF_allocator.context, memory);
   }
-  list->size++;
-  return true;
 }
 
-bool BL_unshift(BL *list, bool v) {
-  BN *boolNode = BN_create(v);
-  if(boolNode == NULL) {
-    return false;
+static void * STF_mallocOut(size_t size) {
+  return STF_allocator.alloc(STF_allocator.context, size);
+}
+
+void STF_free(void *memory) {
+  if(memory != NULL) {
+    STF_allocator.free(STF_allocator.context, memory);
   }
-  if(list->size == 0) {
-    list->start = list->end = boolNode;
-  }else if(list->size == 1) {
-    list->start = boolNode;
-    list->start->next = list->end;
-  }else {
-    BN *tmpNode = list->start;
-    list->start = boolNode;
-    list->start->next = tmpNode;
+}
+
+static void * STF_allocWith(const STF_Allocator *allocator, size_t size) {
+  return allocator == NULL ? STF_malloc(size) : allocator->alloc(allocator->context, size);
+}
+
+static void * STF_callocWith(const STF_Allocator *allocator, size_t count, size_t size) {
+  void *memory = STF_allocWith(allocator, count * size);
+  if(memory != NULL) {
+    memset(memory, 0, count * size);
   }
-  list->size++;
-  return true;
+  return memory;
 }
 
-bool BL_pop(BL *list) {
-  bool v = false;
-  if(list->size > 2) {
-    v = list->end->value;
-    free(list->end);
-    list->end = BL_getNode(list, list->size - 2);
-    list->end->next = NULL;
-    list->size--;
-  }else if(list->size == 2) {
-    v = list->end->value;
-    free(list->end);
-    list->start->next = list->end = NULL;
-    list->size = 1;
-  }else if(list->size == 1) {
-    v = list->start->value;
-    free(list->start);
-    list->start = NULL;
-    list->size = 0;
+static void * STF_reallocWith(const STF_Allocator *allocator, void *memory, size_t size) {
+  return allocator == NULL ? STF_realloc(memory, size) : allocator->realloc(allocator->context, memory, size);
+}
+
+static void STF_freeWith(const STF_Allocator *allocator, void *memory) {
+  if(allocator == NULL) {
+    STF_release(memory);
+  }else if(memory != NULL) {
+    allocator->free(allocator->context, memory);
   }
-  return v;
 }
 
-bool BL_shift(BL *list) {
-  bool v = false;
-  if(list->size > 1) {
-    BN *tmpNode = list->start->next;
-    v = list->start->value;
-    free(list->start);
-    list->start = tmpNode;
-    list->size--;
-  }else if(list->size == 1) {
-    v = list->start->value;
-    free(list->start);
-    list->start = NULL;
-    list->size = 0;
+static void * STF_Arena_alloc(STF_Arena *arena, size_t size) {
+  size = (size + 15) / 16 * 16;
+  if(size > arena->available) {
+    // the first 16 bytes of each block hold the address of the previous block
+    size_t blockSize = arena->blockSize * 2 > size ? arena->blockSize * 2 : size;
+    char *block = (char *)STF_malloc(blockSize + 16);
+    if(block == NULL) {
+      return NULL;
+    }
+    *(char **)block = arena->blocks;
+    arena->blocks = block;
+    arena->cursor = block + 16;
+    arena->available = arena->blockSize = blockSize;
   }
-  return v;
+  void *memory = arena->cursor;
+  arena->cursor += size;
+  arena->available -= size;
+  return memory;
 }
 
-bool BL_insert(BL *list, bool v, int index) {
-  if(index < 0 || index > list->size) {
+static bool _STF_Arena_track(STF_Arena *arena, void *list, char type) {
+  STF_ArenaList *item = (STF_ArenaList *)STF_Arena_alloc(arena, sizeof(STF_ArenaList));
+  if(item == NULL) {
     return false;
   }
-  if(index == 0) {
-    if(!BL_unshift(list, v)) return false;
-  }else if(index == list->size) {
-    if(!BL_add(list, v)) return false;
-  }else {
-    BN *previousNode = BL_getNode(list, index - 1);
-    BN *currentNode = BN_create(v);
-    if(currentNode == NULL) return false;
-    currentNode->next = previousNode->next;
-    previousNode->next = currentNode;
-    list->size++;
-  }
+  item->list = list;
+  item->type = type;
+  item->next = arena->lists;
+  arena->lists = item;
   return true;
 }
 
-bool BL_remove(BL *list, int index) {
-  bool v = false;
-  if(index >= 0 && index < list->size) {
-    if(index == 0) {
-      v = BL_shift(list);
-    }else if(index == list->size - 1) {
-      v = BL_pop(list);
-    }else {
-      BN *previousBN = BL_getNode(list, index - 1);
-      BN *boolNode = previousBN->next;
-      v = boolNode->value;
-      previousBN->next = boolNode->next;
-      free(boolNode);
-      list->size--;
+STF_Arena * STF_Arena_create() {
+  STF_Arena *arena = (STF_Arena *)STF_malloc(sizeof(STF_Arena));
+  if(arena == NULL) {
+    return NULL;
+  }
+  arena->blocks = arena->cursor = NULL;
+  arena->available = 0;
+  arena->blockSize = 2048;
+  arena->lists = NULL;
+  return arena;
+}
+
+void STF_Arena_reset(STF_Arena *arena) {
+  for(STF_ArenaList *item = arena->lists;item != NULL;item = item->next) {
+    switch(item->type) {
+      case 'B': BL_delete((BL *)item->list); break;
+      case 'C': CL_delete((CL *)item->list); break;
+      case 'I': IL_delete((IL *)item->list); break;
+      case 'D': DL_delete((DL *)item->list); break;
+      case 'S': SL_delete((SL *)item->list); break;
     }
   }
-  return v;
+  arena->lists = NULL;
+  if(arena->blocks == NULL) {
+    return;
+  }
+  char *block = *(char **)arena->blocks;
+  while(block != NULL) {
+    char *previousBlock = *(char **)block;
+    STF_release(block);
+    block = previousBlock;
+  }
+  *(char **)arena->blocks = NULL;
+  arena->cursor = arena->blocks + 16;
+  arena->available = arena->blockSize;
 }
 
-void BL_clear(BL *list) {
-  for(int i = 0, size = list->size;i < size;i++) {
-    BL_shift(list);
+void STF_Arena_delete(STF_Arena *arena) {
+  if(arena == NULL) {
+    return;
   }
+  STF_Arena_reset(arena);
+  STF_release(arena->blocks);
+  STF_release(arena);
 }
 
-void BL_delete(BL *list) {
-  BL_clear(list);
-  free(list);
+static STF_Pool * STF_Pool_create(int nodeSize) {
+  return STF_Pool_createIn(NULL, NULL, nodeSize);
 }
 
-bool BL_set(BL *list, bool v, int index) {
-  if(index >= 0 && index < list->size) {
-    BN *tmpNode = list->start;
-    for(int i = 0;i < list->size;i++) {
-      if(i == index) {
-        tmpNode->value = v;
-        return true;
-      }
-      tmpNode = tmpNode->next;
-    }
+static STF_Pool * STF_Pool_createIn(STF_Arena *arena, const STF_Allocator *allocator, int nodeSize) {
+  STF_Pool *pool = (STF_Pool *)(arena == NULL ? STF_allocWith(allocator, sizeof(STF_Pool)) : STF_Arena_alloc(arena, sizeof(STF_Pool)));
+  if(pool == NULL) {
+    return NULL;
   }
-  return false;
+  pool->arena = arena;
+  pool->allocator = allocator;
+  pool->chunks = pool->freeNodes = NULL;
+  pool->cursor = NULL;
+  pool->available = 0;
+  pool->nodeSize = nodeSize;
+  pool->chunkLength = 8;
+  return pool;
 }
 
-bool BL_get(BL *list, int index) {
-  if(index < 0 || index >= list->size) {
+static STF_Pool * STF_Pool_createLike(STF_Pool *pool, int nodeSize) {
+  return pool == NULL ? STF_Pool_create(nodeSize) : STF_Pool_createIn(pool->arena, pool->allocator, nodeSize);
+}
+
+static const STF_Allocator * STF_Pool_allocator(STF_Pool *pool) {
+  return pool == NULL ? NULL : pool->allocator;
+}
+
+static bool STF_Pool_grow(STF_Pool *pool, int length) {
+  // the first node of each chunk holds the address of the previous chunk
+  size_t size = (size_t)pool->nodeSize * (length + 1);
+  char *chunk = (char *)(pool->arena == NULL ? STF_allocWith(pool->allocator, size) : STF_Arena_alloc(pool->arena, size));
+  if(chunk == NULL) {
     return false;
   }
-  BN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i == index) {
-      return tmpNode->value;
-    }
-    tmpNode = tmpNode->next;
-  }
+  *(void **)chunk = pool->chunks;
+  pool->chunks = chunk;
+  pool->cursor = chunk + pool->nodeSize;
+  pool->available = length;
+  return true;
 }
 
-bool * BL_toBoolArray(BL *list) {
-  bool *array = (bool*)malloc(list->size * sizeof(bool));
-  if(array == NULL) {
-    return NULL;
+static void * STF_Pool_alloc(STF_Pool *pool) {
+  void *node = pool->freeNodes;
+  if(node != NULL) {
+    pool->freeNodes = *(void **)node;
+    return node;
   }
-  BN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    array[i] = tmpNode->value;
-    tmpNode = tmpNode->next;
+  if(pool->available == 0) {
+    if(!STF_Pool_grow(pool, pool->chunkLength)) {
+      return NULL;
+    }else if(pool->chunkLength < 65536) {
+      pool->chunkLength *= 2;
+    }
   }
-  return array;
+  node = pool->cursor;
+  pool->cursor += pool->nodeSize;
+  pool->available--;
+  return node;
 }
 
-void BL_sort(BL *list) {
-  _BL_sort(list, false);  
+static bool STF_Pool_reserve(STF_Pool *pool, int count) {
+  if(pool->available >= count) {
+    return true;
+  }
+  // a bulk build knows its size, a bigger chunk would only be wasted on small lists
+  return STF_Pool_grow(pool, count);
 }
 
-void BL_rsort(BL *list) {
-  _BL_sort(list, true);
+static void STF_Pool_free(STF_Pool *pool, void *node) {
+  *(void **)node = pool->freeNodes;
+  pool->freeNodes = node;
 }
 
-BL * BL_createFrom(bool *array, int len) {
-  BL *list = BL_create();
-  if(list == NULL) {
-    return NULL;
+static void STF_Pool_merge(STF_Pool *pool, STF_Pool *other) {
+  if(other->chunks != NULL) {
+    void *chunk = other->chunks;
+    while(*(void **)chunk != NULL) {
+      chunk = *(void **)chunk;
+    }
+    *(void **)chunk = pool->chunks;
+    pool->chunks = other->chunks;
   }
-  int i = 0;
-  while(i < len) {
-    if(!BL_add(list, array[i])) {
-      BL_delete(list);
-      return NULL;
+  if(other->freeNodes != NULL) {
+    void *node = other->freeNodes;
+    while(*(void **)node != NULL) {
+      node = *(void **)node;
     }
-    i++;
+    *(void **)node = pool->freeNodes;
+    pool->freeNodes = other->freeNodes;
   }
-  return list;
+  // keep cutting from whichever chunk has more room left
+  if(other->available > pool->available) {
+    pool->cursor = other->cursor;
+    pool->available = other->available;
+  }
+  other->chunks = other->freeNodes = NULL;
+  other->cursor = NULL;
+  other->available = 0;
 }
 
-BL * BL_copy(BL *list) {
-  BL *listCopy = BL_create();
-  if(listCopy == NULL) {
-    return NULL;
+static void STF_Pool_reset(STF_Pool *pool) {
+  // chunks cut out of an arena go back with the arena
+  void *chunk = pool->arena == NULL ? pool->chunks : NULL;
+  while(chunk != NULL) {
+    void *previousChunk = *(void **)chunk;
+    STF_freeWith(pool->allocator, chunk);
+    chunk = previousChunk;
   }
-  BN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(!BL_add(listCopy, tmpNode->value)) {
-      BL_delete(listCopy);
-      return NULL;
-    }
-    tmpNode = tmpNode->next;
+  pool->chunks = pool->freeNodes = NULL;
+  pool->cursor = NULL;
+  pool->available = 0;
+}
+
+static void STF_Pool_delete(STF_Pool *pool) {
+  if(pool == NULL) {
+    return;
+  }
+  STF_Pool_reset(pool);
+  if(pool->arena == NULL) {
+    STF_freeWith(pool->allocator, pool);
   }
-  return listCopy;
 }
 
-bool BL_concatArray(BL *list, bool *array, int len) {
-  int i = 0;
-  while(i < len) {
-    if(!BL_add(list, array[i])) {
-      return false;
-    }
-    i++;
+static unsigned STF_hash(String chars, int length) {
+  unsigned code = 2166136261u;
+  for(int i = 0;i < length;i++) {
+    code = (code ^ (unsigned char)chars[i]) * 16777619u;
   }
-  return true;
+  return code;
 }
 
-bool BL_concatList(BL *listA, BL *listB) {
-  BN *tmpNode = listB->start;
-  for(int i = 0;i < listB->size;i++) {
-    if(!BL_add(listA, tmpNode->value)) {
-      return false;
+static STF_Hash * STF_Hash_create(const STF_Allocator *allocator, bool ownsKeys) {
+  STF_Hash *hash = (STF_Hash *)STF_allocWith(allocator, sizeof(STF_Hash));
+  if(hash == NULL) {
+    return NULL;
+  }
+  hash->allocator = allocator;
+  hash->entries = NULL;
+  hash->capacity = hash->size = 0;
+  hash->ownsKeys = ownsKeys;
+  hash->isStale = false;
+  return hash;
+}
+
+static STF_HashEntry * STF_Hash_find(STF_Hash *hash, String chars, int length, unsigned code) {
+  int mask = hash->capacity - 1;
+  for(int i = code & mask;;i = (i + 1) & mask) {
+    STF_HashEntry *entry = hash->entries + i;
+    if(entry->chars == NULL || (entry->code == code && entry->length == length &&
+       memcmp(entry->chars, chars, length) == 0)) {
+      return entry;
     }
-    tmpNode = tmpNode->next;
   }
-  return true;
 }
 
-bool BL_reverse(BL *list) {
-  BL *tmpBL = BL_create();
-  if(tmpBL == NULL) {
+static bool _STF_Hash_grow(STF_Hash *hash) {
+  int capacity = hash->capacity == 0 ? 16 : hash->capacity * 2;
+  STF_HashEntry *entries = (STF_HashEntry *)STF_callocWith(hash->allocator, capacity, sizeof(STF_HashEntry));
+  if(entries == NULL) {
     return false;
   }
-  BN *tmpNode = list->start;
-  for(int i = 0;i < list->size; i++) {
-    if(!BL_unshift(tmpBL, tmpNode->value)) {
-      BL_delete(tmpBL);
-      return false;
+  STF_HashEntry *oldEntries = hash->entries;
+  int oldCapacity = hash->capacity;
+  hash->entries = entries;
+  hash->capacity = capacity;
+  for(int i = 0;i < oldCapacity;i++) {
+    if(oldEntries[i].chars != NULL) {
+      *STF_Hash_find(hash, oldEntries[i].chars, oldEntries[i].length, oldEntries[i].code) = oldEntries[i];
     }
-    tmpNode = tmpNode->next;
   }
-  BL_clear(list);
-  list->start = tmpBL->start;
-  list->end = tmpBL->end;
-  list->size = tmpBL->size;
-  free(tmpBL);
+  STF_release(oldEntries);
   return true;
 }
 
-BL * BL_slice(BL *list, int start, int end) {
-  if(start >= list->size || start < 0 || end <= start) {
-    return NULL;
-  }
-  BL *listSub = BL_create();
-  if(listSub == NULL) {
+static STF_HashEntry * STF_Hash_add(STF_Hash *hash, String chars, int length) {
+  // keep the table at most three quarters full
+  if((hash->size + 1) * 4 > hash->capacity * 3 && !_STF_Hash_grow(hash)) {
     return NULL;
   }
-  BN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i >= start && i < end) {
-      if(!BL_add(listSub, tmpNode->value)) {
-        BL_delete(listSub);
+  unsigned code = STF_hash(chars, length);
+  STF_HashEntry *entry = STF_Hash_find(hash, chars, length, code);
+  if(entry->chars == NULL) {
+    String key = chars;
+    if(hash->ownsKeys) {
+      // the address of the table goes in front of the copy so the key leads back to it
+      char *block = (char *)STF_allocWith(hash->allocator, sizeof(STF_Hash *) + length + 1);
+      if(block == NULL) {
         return NULL;
       }
+      memcpy(block, &hash, sizeof(STF_Hash *));
+      key = block + sizeof(STF_Hash *);
+      memcpy(key, chars, length);
+      key[length] = '\0';
     }
-    if(i == end - 1) {
-      return listSub;
-    }
-    tmpNode = tmpNode->next;
+    entry->chars = key;
+    entry->length = length;
+    entry->code = code;
+    entry->count = 0;
+    hash->size++;
   }
-  return listSub;
+  entry->count++;
+  return entry;
 }
 
-BL * BL_sub(BL *list, int start, int length) {
-  if(start >= list->size || start < 0 || length < 1) {
-    return NULL;
+static void STF_Hash_remove(STF_Hash *hash, String chars, int length) {
+  if(hash->size == 0) {
+    return;
   }
-  BL *listSub = BL_create();
-  if(listSub == NULL) {
-    return NULL;
+  STF_HashEntry *entry = STF_Hash_find(hash, chars, length, STF_hash(chars, length));
+  if(entry->chars != NULL) {
+    STF_Hash_removeEntry(hash, entry);
   }
-  BN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i >= start && i < start + length) {
-      if(!BL_add(listSub, tmpNode->value)) {
-        BL_delete(listSub);
-        return NULL;
-      }
-    }
-    if(i > start + length - 1) {
-      return listSub;
+}
+
+static void STF_Hash_removeEntry(STF_Hash *hash, STF_HashEntry *entry) {
+  if(--entry->count > 0) {
+    return;
+  }
+  if(hash->ownsKeys) {
+    STF_freeWith(hash->allocator, entry->chars - sizeof(STF_Hash *));
+  }
+  hash->size--;
+  // shift the following entries back so no probe chain is broken
+  int mask = hash->capacity - 1, hole = entry - hash->entries;
+  for(int i = (hole + 1) & mask;hash->entries[i].chars != NULL;i = (i + 1) & mask) {
+    int home = hash->entries[i].code & mask;
+    if(((i - home) & mask) >= ((i - hole) & mask)) {
+      hash->entries[hole] = hash->entries[i];
+      hole = i;
     }
-    tmpNode = tmpNode->next;
   }
-  return listSub;
+  hash->entries[hole].chars = NULL;
 }
 
-bool BL_startsWith(BL *list, bool v) {
-  return list->size > 0 && list->start->value == v;
+static int STF_Hash_count(STF_Hash *hash, String chars, int length) {
+  if(hash->size == 0) {
+    return 0;
+  }
+  STF_HashEntry *entry = STF_Hash_find(hash, chars, length, STF_hash(chars, length));
+  return entry->chars == NULL ? 0 : entry->count;
 }
 
-bool BL_endsWith(BL *list, bool v) {
-  return list->size == 1 && list->start->value == v ||
-    list->size > 0 && list->end->value == v;
+static void STF_Hash_clear(STF_Hash *hash) {
+  for(int i = 0;i < hash->capacity && hash->size > 0;i++) {
+    if(hash->entries[i].chars != NULL) {
+      if(hash->ownsKeys) {
+        STF_freeWith(hash->allocator, hash->entries[i].chars - sizeof(STF_Hash *));
+      }
+      hash->entries[i].chars = NULL;
+      hash->size--;
+    }
+  }
 }
 
-bool BL_contains(BL *list, bool v) {
-  BN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      return true;
-    }
-    tmpNode = tmpNode->next;
+static void STF_Hash_delete(STF_Hash *hash) {
+  if(hash == NULL) {
+    return;
   }
-  return false;
+  STF_Hash_clear(hash);
+  // the table is read before it's given back
+  const STF_Allocator *allocator = hash->allocator;
+  STF_freeWith(allocator, hash->entries);
+  STF_freeWith(allocator, hash);
 }
 
-bool BL_isEmpty(BL *list) {
-  return list->size == 0 ? 1 : 0;
+static STF_Hash * STF_Hash_ownerOf(String key) {
+  STF_Hash *hash;
+  memcpy(&hash, key - sizeof(STF_Hash *), sizeof(STF_Hash *));
+  return hash;
 }
 
-int BL_compare(BL *listA, BL *listB) {
-  int len = listA->size > listB->size ? listB->size : listA->size;
-  BN *tmpNodeA = listA->start;
-  BN *tmpNodeB = listB->start;
-  for(int i = 0;i < len;i++) {
-    if(tmpNodeA->value < tmpNodeB->value) {
-      return 1;
-    }else if(tmpNodeA->value > tmpNodeB->value) {
-      return -1;
-    }
-    tmpNodeA = tmpNodeA->next;
-    tmpNodeB = tmpNodeB->next;
+STF_Intern * STF_Intern_create(void) {
+  return STF_Hash_create(NULL, true);
+}
+
+void STF_Intern_delete(STF_Intern *intern) {
+  STF_Hash_delete(intern);
+}
+
+static String STF_intern(STF_Intern *intern, String chars, int length) {
+  STF_HashEntry *entry = STF_Hash_add(intern, chars, length);
+  return entry == NULL ? NULL : entry->chars;
+}
+
+static void STF_unintern(String chars, int length) {
+  STF_Hash_remove(STF_Hash_ownerOf(chars), chars, length);
+}
+
+static String STF_internFind(STF_Intern *intern, String chars, int length) {
+  // a table that never got a string may have no slots to probe
+  if(intern == NULL || intern->size == 0) {
+    return NULL;
+  }
+  return STF_Hash_find(intern, chars, length, STF_hash(chars, length))->chars;
+}
+static STF_IntSet * STF_IntSet_create(int expected) {
+  STF_IntSet *set = (STF_IntSet *)STF_malloc(sizeof(STF_IntSet));
+  if(set == NULL) {
+    return NULL;
+  }
+  // at least twice as many slots as values so the set never fills up
+  set->capacity = 16;
+  while(set->capacity < expected * 2) {
+    set->capacity *= 2;
+  }
+  set->values = (int *)STF_malloc(set->capacity * sizeof(int));
+  set->isUsed = (bool *)STF_calloc(set->capacity, sizeof(bool));
+  if(set->values == NULL || set->isUsed == NULL) {
+    STF_IntSet_delete(set);
+    return NULL;
+  }
+  return set;
+}
+
+static int _STF_IntSet_find(STF_IntSet *set, int v) {
+  unsigned code = (unsigned)v * 2654435761u;
+  int mask = set->capacity - 1;
+  int i = (code ^ code >> 16) & mask;
+  while(set->isUsed[i] && set->values[i] != v) {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+static bool STF_IntSet_add(STF_IntSet *set, int v) {
+  int i = _STF_IntSet_find(set, v);
+  if(set->isUsed[i]) {
+    return false;
+  }
+  set->isUsed[i] = true;
+  set->values[i] = v;
+  return true;
+}
+
+static bool STF_IntSet_contains(STF_IntSet *set, int v) {
+  return set->isUsed[_STF_IntSet_find(set, v)];
+}
+
+static void STF_IntSet_delete(STF_IntSet *set) {
+  if(set == NULL) {
+    return;
+  }
+  STF_release(set->values);
+  STF_release(set->isUsed);
+  STF_release(set);
+}
+
+static void STF_caseTable(unsigned char *table, bool isUpper) {
+  for(int i = 0;i < 256;i++) {
+    table[i] = isUpper ? toupper(i) : tolower(i);
+  }
+}
+
+static int STF_popcount(unsigned long long word) {
+  word = word - (word >> 1 & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + (word >> 2 & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int)(word * 0x0101010101010101ULL >> 56);
+}
+
+
+/*----------------######################################################################----------------*/
+/*----------------#--***** -- **** -- **** --**    ----**    --******--******--******--#----------------*/
+/*----------------#--******--******--******--**    ----**    --******--******--******--#----------------*/
+/*----------------#--**  **--**  **--**  **--**    ----**    --  **  --**    --  **  --#----------------*/
+/*----------------#--******--**  **--**  **--**    ----**    --  **  --******--  **  --#----------------*/
+/*----------------#--******--**  **--**  **--**    ----**    --  **  --******--  **  --#----------------*/
+/*----------------#--**  **--**  **--**  **--**    ----**    --  **  --    **--  **  --#----------------*/
+/*----------------#--******--******--******--******----******--******--******--  **  --#----------------*/
+/*----------------#--***** -- **** -- **** --******----******--******--******--  **  --#----------------*/
+/*----------------######################################################################----------------*/
+
+static BN * BN_create(STF_Pool *pool, bool v) {
+  BN *boolNode = (BN *)(pool == NULL ? STF_malloc(sizeof(BN)) : STF_Pool_alloc(pool));
+  if(boolNode == NULL) {
+    return NULL;
+  }
+  boolNode->value = v;
+  boolNode->next = NULL;
+  return boolNode;
+}
+
+static void BN_delete(STF_Pool *pool, BN *boolNode) {
+  if(pool == NULL) {
+    STF_release(boolNode);
+  }else {
+    STF_Pool_free(pool, boolNode);
+  }
+}
+
+static bool _BL_packedReserve(BL *list, int size) {
+  int wordCount = (size + 63) / 64;
+  if(wordCount <= list->bitCapacity) {
+    return true;
+  }
+  int bitCapacity = list->bitCapacity == 0 ? 1 : list->bitCapacity;
+  while(bitCapacity < wordCount) {
+    bitCapacity *= 2;
+  }
+  unsigned long long *bits = (unsigned long long *)STF_reallocWith(STF_Pool_allocator(list->pool), list->bits, bitCapacity * sizeof(unsigned long long));
+  if(bits == NULL) {
+    return false;
+  }
+  list->bits = bits;
+  list->bitCapacity = bitCapacity;
+  return true;
+}
+
+static void _BL_maskTail(BL *list) {
+  if(list->size % 64 != 0) {
+    list->bits[list->size / 64] &= (1ULL << list->size % 64) - 1;
+  }
+}
+
+static bool _BL_combineBits(BL *listA, BL *listB, char op) {
+  if(listA->size != listB->size) {
+    return false;
+  }else if(listA->isPacked && listB->isPacked) {
+    int wordCount = (listA->size + 63) / 64;
+    if(op == '&') {
+      for(int i = 0;i < wordCount;i++) {
+        listA->bits[i] &= listB->bits[i];
+      }
+    }else if(op == '|') {
+      for(int i = 0;i < wordCount;i++) {
+        listA->bits[i] |= listB->bits[i];
+      }
+    }else {
+      for(int i = 0;i < wordCount;i++) {
+        listA->bits[i] ^= listB->bits[i];
+      }
+    }
+    return true;
+  }
+  for(int i = 0;i < listA->size;i++) {
+    bool a = BL_get(listA, i), b = BL_get(listB, i);
+    BL_set(listA, op == '&' ? a && b : op == '|' ? a || b : a != b, i);
+  }
+  return true;
+}
+
+static BN * BL_getNode(BL *list, int index) {
+  if(index < 0 || index >= list->size) {
+    return NULL;
+  }
+  if(list->isIndexed || _BL_index(list)) {
+    return list->nodes[list->offset + index];
+  }
+  BN *tmpNode = list->start;
+  for(int i = 0;i < index;i++) {
+    tmpNode = tmpNode->next;
+  }
+  return tmpNode;
+}
+
+static bool _BL_reserve(BL *list, int capacity) {
+  if(list->offset + capacity <= list->capacity) {
+    return true;
+  }
+  // slide the table back to the beginning before growing it
+  if(list->isIndexed && list->offset > 0) {
+    memmove(list->nodes, list->nodes + list->offset, list->size * sizeof(BN *));
+  }
+  list->offset = 0;
+  if(capacity <= list->capacity) {
+    return true;
+  }
+  int newCapacity = list->capacity == 0 ? 16 : list->capacity;
+  while(newCapacity < capacity) {
+    newCapacity *= 2;
+  }
+  BN **nodes = (BN **)STF_reallocWith(STF_Pool_allocator(list->pool), list->nodes, newCapacity * sizeof(BN *));
+  if(nodes == NULL) {
+    return false;
+  }
+  list->nodes = nodes;
+  list->capacity = newCapacity;
+  return true;
+}
+
+static bool _BL_index(BL *list) {
+  // a view shares the nodes of another list and never owns a table
+  if(list->isView) {
+    return false;
+  }
+  list->offset = 0;
+  if(!_BL_reserve(list, list->size)) {
+    return false;
+  }
+  BN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    list->nodes[i] = tmpNode;
+    tmpNode = tmpNode->next;
+  }
+  list->isIndexed = true;
+  return true;
+}
+
+static void _BL_indexInsert(BL *list, BN *node, int index) {
+  if(!list->isIndexed) {
+    return;
+  }
+  if(index < list->size / 2 && list->offset > 0) {
+    list->offset--;
+    memmove(list->nodes + list->offset, list->nodes + list->offset + 1, index * sizeof(BN *));
+  }else if(index == 0) {
+    // no room in front of the table, it's cheaper to rebuild it when needed
+    list->isIndexed = false;
+    return;
+  }else {
+    if(!_BL_reserve(list, list->size + 1)) {
+      list->isIndexed = false;
+      return;
+    }
+    memmove(list->nodes + list->offset + index + 1, list->nodes + list->offset + index,
+      (list->size - index) * sizeof(BN *));
+  }
+  list->nodes[list->offset + index] = node;
+}
+
+static void _BL_indexRemove(BL *list, int index) {
+  if(!list->isIndexed || index >= list->size) {
+    return;
+  }
+  if(index < list->size / 2) {
+    memmove(list->nodes + list->offset + 1, list->nodes + list->offset, index * sizeof(BN *));
+    list->offset++;
+  }else {
+    memmove(list->nodes + list->offset + index, list->nodes + list->offset + index + 1,
+      (list->size - index - 1) * sizeof(BN *));
+  }
+}
+
+static void _BL_sort(BL *list, bool isReversed) {
+  if(list->isPacked) {
+    int trueCount = BL_count(list, true);
+    for(int i = 0;i < list->size;i++) {
+      BL_set(list, isReversed ? i < trueCount : i >= list->size - trueCount, i);
+    }
+    return;
+  }
+  int trueCount = 0;
+  BN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    trueCount += tmpNode->value;
+    tmpNode = tmpNode->next;
+  }
+  int falseCount = list->size - trueCount;
+  tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    tmpNode->value = isReversed ? i < trueCount : i >= falseCount;
+    tmpNode = tmpNode->next;
+  }
+}
+
+static bool _BL_append(BL *list, bool *array, BN *source, int len) {
+  if(len <= 0) {
+    return true;
+  }else if(list->pool != NULL && !STF_Pool_reserve(list->pool, len)) {
+    return false;
+  }
+  BN *first = NULL, *last = NULL;
+  for(int i = 0;i < len;i++) {
+    BN *boolNode = BN_create(list->pool, array != NULL ? array[i] : source->value);
+    if(boolNode == NULL) {
+      while(first != NULL) {
+        BN *tmpNode = first->next;
+        BN_delete(list->pool, first);
+        first = tmpNode;
+      }
+      return false;
+    }
+    if(first == NULL) {
+      first = boolNode;
+    }else {
+      last->next = boolNode;
+    }
+    last = boolNode;
+    if(array == NULL) {
+      source = source->next;
+    }
+  }
+  if(list->size == 0) {
+    list->start = first;
+  }else {
+    list->end->next = first;
+  }
+  list->end = last;
+  if(list->isIndexed && _BL_reserve(list, list->size + len)) {
+    BN **nodes = list->nodes + list->offset + list->size;
+    for(BN *tmpNode = first;tmpNode != NULL;tmpNode = tmpNode->next) {
+      *nodes++ = tmpNode;
+    }
+  }else {
+    list->isIndexed = false;
+  }
+  list->size += len;
+  return true;
+}
+
+BL * BL_create() {
+  BL *list = (BL *)STF_malloc(sizeof(BL));
+  if(list == NULL) {
+    return NULL;
+  }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->pool = NULL;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->bits = NULL;
+  list->bitCapacity = 0;
+  list->isView = false;
+  list->isPacked = false;
+  return list;
+}
+
+BL * BL_createPooled() {
+  BL *list = BL_create();
+  if(list == NULL) {
+    return NULL;
+  }
+  list->pool = STF_Pool_create(sizeof(BN));
+  if(list->pool == NULL) {
+    STF_release(list);
+    return NULL;
+  }
+  return list;
+}
+
+BL * BL_createIn(STF_Arena *arena) {
+  BL *list = (BL *)STF_Arena_alloc(arena, sizeof(BL));
+  if(list == NULL) {
+    return NULL;
+  }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->bits = NULL;
+  list->bitCapacity = 0;
+  list->isView = false;
+  list->isPacked = false;
+  // the list is only tracked once it can be deleted like any arena list
+  list->pool = STF_Pool_createIn(arena, NULL, sizeof(BN));
+  if(list->pool == NULL || !_STF_Arena_track(arena, list, 'B')) {
+    return NULL;
+  }
+  return list;
+}
+
+BL * BL_createWith(const STF_Allocator *allocator) {
+  BL *list = (BL *)STF_allocWith(allocator, sizeof(BL));
+  if(list == NULL) {
+    return NULL;
+  }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->bits = NULL;
+  list->bitCapacity = 0;
+  list->isView = false;
+  list->isPacked = false;
+  list->pool = STF_Pool_createIn(NULL, allocator, sizeof(BN));
+  if(list->pool == NULL) {
+    STF_freeWith(allocator, list);
+    return NULL;
+  }
+  return list;
+}
+
+bool BL_compact(BL *list) {
+  if(list->isView) {
+    return false;
+  }else if(list->size == 0 || list->isPacked) {
+    return true;
+  }
+  STF_Pool *pool = STF_Pool_createLike(list->pool, sizeof(BN));
+  if(pool == NULL || !STF_Pool_grow(pool, list->size)) {
+    STF_Pool_delete(pool);
+    return false;
+  }
+  BN *tmpNode = list->start, *lastNode = NULL;
+  for(int i = 0;i < list->size;i++) {
+    BN *newNode = (BN *)STF_Pool_alloc(pool);
+    *newNode = *tmpNode;
+    if(lastNode == NULL) {
+      list->start = newNode;
+    }else {
+      lastNode->next = newNode;
+    }
+    if(list->isIndexed) {
+      list->nodes[list->offset + i] = newNode;
+    }
+    lastNode = newNode;
+    BN *nextNode = tmpNode->next;
+    if(list->pool == NULL) {
+      STF_release(tmpNode);
+    }
+    tmpNode = nextNode;
+  }
+  list->end = lastNode;
+  // every node of a pooled list lives in its chunks, so the old pool can go at once
+  STF_Pool_delete(list->pool);
+  list->pool = pool;
+  return true;
+}
+BL * BL_createPacked() {
+  BL *list = BL_create();
+  if(list == NULL) {
+    return NULL;
+  }
+  list->isPacked = true;
+  return list;
+}
+
+bool BL_pack(BL *list) {
+  if(list->isPacked) {
+    return true;
+  }else if(list->isView) {
+    return false;
+  }
+  int wordCount = (list->size + 63) / 64;
+  unsigned long long *bits = NULL;
+  if(wordCount > 0 && (bits = (unsigned long long *)STF_callocWith(STF_Pool_allocator(list->pool), wordCount, sizeof(unsigned long long))) == NULL) {
+    return false;
+  }
+  STF_Pool *pool = NULL;
+  if(list->pool != NULL && (pool = STF_Pool_createLike(list->pool, sizeof(BN))) == NULL) {
+    STF_freeWith(STF_Pool_allocator(list->pool), bits);
+    return false;
+  }
+  BN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    bits[i / 64] |= (unsigned long long)tmpNode->value << i % 64;
+    BN *nextNode = tmpNode->next;
+    if(pool == NULL) {
+      STF_release(tmpNode);
+    }
+    tmpNode = nextNode;
+  }
+  // the nodes of a pooled list all go away with its chunks
+  if(pool != NULL) {
+    STF_Pool_delete(list->pool);
+    list->pool = pool;
+  }
+  STF_freeWith(STF_Pool_allocator(list->pool), list->nodes);
+  list->nodes = NULL;
+  list->capacity = list->offset = 0;
+  list->isIndexed = false;
+  list->start = list->end = NULL;
+  list->bits = bits;
+  list->bitCapacity = wordCount;
+  list->isPacked = true;
+  return true;
+}
+
+bool BL_unpack(BL *list) {
+  if(!list->isPacked) {
+    return true;
+  }
+  bool *array = BL_toBoolArray(list);
+  if(array == NULL && list->size > 0) {
+    return false;
+  }
+  int size = list->size;
+  list->isPacked = false;
+  list->size = 0;
+  if(!_BL_append(list, array, NULL, size)) {
+    list->isPacked = true;
+    list->size = size;
+    STF_free(array);
+    return false;
+  }
+  STF_free(array);
+  STF_freeWith(STF_Pool_allocator(list->pool), list->bits);
+  list->bits = NULL;
+  list->bitCapacity = 0;
+  return true;
+}
+
+
+bool BL_add(BL *list, bool v) {
+  if(list->isPacked) {
+    if(!_BL_packedReserve(list, list->size + 1)) {
+      return false;
+    }else if(list->size % 64 == 0) {
+      list->bits[list->size / 64] = 0;
+    }
+    list->bits[list->size / 64] |= (unsigned long long)v << list->size % 64;
+    list->size++;
+    return true;
+  }
+  BN *boolNode = BN_create(list->pool, v);
+  if(boolNode == NULL) {
+    return false;
+  }
+  if(list->size == 0) {
+    list->start = list->end = boolNode;
+  }else if(list->size == 1) {
+    list->start->next = list->end = boolNode;
+  }else {
+    list->end->next = boolNode;
+    list->end = list->end->next;
+  }
+  _BL_indexInsert(list, boolNode, list->size);
+  list->size++;
+  return true;
+}
+
+bool BL_unshift(BL *list, bool v) {
+  if(list->isPacked && !BL_unpack(list)) {
+    return false;
+  }
+  BN *boolNode = BN_create(list->pool, v);
+  if(boolNode == NULL) {
+    return false;
+  }
+  if(list->size == 0) {
+    list->start = list->end = boolNode;
+  }else if(list->size == 1) {
+    list->start = boolNode;
+    list->start->next = list->end;
+  }else {
+    BN *tmpNode = list->start;
+    list->start = boolNode;
+    list->start->next = tmpNode;
+  }
+  _BL_indexInsert(list, boolNode, 0);
+  list->size++;
+  return true;
+}
+
+bool BL_pop(BL *list) {
+  if(list->isPacked) {
+    bool v = BL_get(list, list->size - 1);
+    if(list->size > 0) {
+      list->size--;
+      _BL_maskTail(list);
+    }
+    return v;
+  }
+  bool v = false;
+  if(list->size > 2) {
+    v = list->end->value;
+    BN *previousNode = BL_getNode(list, list->size - 2);
+    BN_delete(list->pool, list->end);
+    list->end = previousNode;
+    list->end->next = NULL;
+    list->size--;
+  }else if(list->size == 2) {
+    v = list->end->value;
+    BN_delete(list->pool, list->end);
+    list->start->next = NULL;
+    list->end = list->start;
+    list->size = 1;
+  }else if(list->size == 1) {
+    v = list->start->value;
+    BN_delete(list->pool, list->start);
+    list->start = list->end = NULL;
+    list->size = 0;
+  }
+  return v;
+}
+
+bool BL_shift(BL *list) {
+  if(list->isPacked && !BL_unpack(list)) {
+    return false;
+  }
+  bool v = false;
+  _BL_indexRemove(list, 0);
+  if(list->size > 1) {
+    BN *tmpNode = list->start->next;
+    v = list->start->value;
+    BN_delete(list->pool, list->start);
+    list->start = tmpNode;
+    list->size--;
+  }else if(list->size == 1) {
+    v = list->start->value;
+    BN_delete(list->pool, list->start);
+    list->start = list->end = NULL;
+    list->size = 0;
+  }
+  return v;
+}
+
+bool BL_insert(BL *list, bool v, int index) {
+  if(list->isPacked && !BL_unpack(list)) {
+    return false;
+  }
+  if(index < 0 || index > list->size) {
+    return false;
+  }
+  if(index == 0) {
+    if(!BL_unshift(list, v)) return false;
+  }else if(index == list->size) {
+    if(!BL_add(list, v)) return false;
+  }else {
+    BN *previousNode = BL_getNode(list, index - 1);
+    BN *currentNode = BN_create(list->pool, v);
+    if(currentNode == NULL) return false;
+    currentNode->next = previousNode->next;
+    previousNode->next = currentNode;
+    _BL_indexInsert(list, currentNode, index);
+    list->size++;
+  }
+  return true;
+}
+
+bool BL_remove(BL *list, int index) {
+  if(list->isPacked && !BL_unpack(list)) {
+    return false;
+  }
+  bool v = false;
+  if(index >= 0 && index < list->size) {
+    if(index == 0) {
+      v = BL_shift(list);
+    }else if(index == list->size - 1) {
+      v = BL_pop(list);
+    }else {
+      BN *previousBN = BL_getNode(list, index - 1);
+      BN *boolNode = previousBN->next;
+      v = boolNode->value;
+      previousBN->next = boolNode->next;
+      BN_delete(list->pool, boolNode);
+      _BL_indexRemove(list, index);
+      list->size--;
+    }
+  }
+  return v;
+}
+
+void BL_clear(BL *list) {
+  if(list->isPacked) {
+    list->size = 0;
+    return;
+  }
+  if(list->isView) {
+    // a view doesn't own its nodes, they stay with the list it was made from
+  }else if(list->pool != NULL) {
+    STF_Pool_reset(list->pool);
+  }else {
+    BN *tmpNode = list->start;
+    for(int i = 0;i < list->size;i++) {
+      BN *nextNode = tmpNode->next;
+      STF_release(tmpNode);
+      tmpNode = nextNode;
+    }
+  }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->offset = 0;
+}
+
+void BL_delete(BL *list) {
+  // a list made in an arena keeps its header until the arena is reset
+  bool isInArena = list->pool != NULL && list->pool->arena != NULL;
+  const STF_Allocator *allocator = STF_Pool_allocator(list->pool);
+  BL_clear(list);
+  STF_Pool_delete(list->pool);
+  STF_freeWith(allocator, list->nodes);
+  STF_freeWith(allocator, list->bits);
+  if(isInArena) {
+    list->nodes = NULL;
+    list->capacity = 0;
+    list->isIndexed = false;
+    list->bits = NULL;
+    list->bitCapacity = 0;
+    return;
+  }
+  STF_freeWith(allocator, list);
+}
+
+bool BL_set(BL * list, bool v, int index) {
+  if(list->isPacked) {
+    if(index < 0 || index >= list->size) {
+      return false;
+    }
+    list->bits[index / 64] = (list->bits[index / 64] & ~(1ULL << index % 64)) | (unsigned long long)v << index % 64;
+    return true;
+  }
+  BN *tmpNode = BL_getNode(list, index);
+  if(tmpNode == NULL) {
+    return false;
+  }
+  tmpNode->value = v;
+  return true;
+}
+
+bool BL_get(BL * list, int index) {
+  if(list->isPacked) {
+    return index >= 0 && index < list->size && list->bits[index / 64] >> index % 64 & 1;
+  }
+  BN *tmpNode = BL_getNode(list, index);
+  return tmpNode == NULL ? false : tmpNode->value;
+}
+
+bool * BL_toBoolArray(BL *list) {
+  bool *array = (bool*)STF_mallocOut(list->size * sizeof(bool));
+  if(array == NULL) {
+    return NULL;
+  }
+  if(list->isPacked) {
+    for(int i = 0;i < list->size;i++) {
+      array[i] = list->bits[i / 64] >> i % 64 & 1;
+    }
+    return array;
+  }
+  BN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    array[i] = tmpNode->value;
+    tmpNode = tmpNode->next;
+  }
+  return array;
+}
+
+void BL_sort(BL *list) {
+  _BL_sort(list, false);  
+}
+
+void BL_rsort(BL *list) {
+  _BL_sort(list, true);
+}
+
+BL * BL_createFrom(bool *array, int len) {
+  BL *list = BL_createPooled();
+  if(list == NULL) {
+    return NULL;
+  }else if(!_BL_append(list, array, NULL, len)) {
+    BL_delete(list);
+    return NULL;
+  }
+  return list;
+}
+
+BL * BL_copy(BL *list) {
+  if(list->isPacked) {
+    BL *listCopy = BL_createPacked();
+    if(listCopy == NULL) {
+      return NULL;
+    }else if(!_BL_packedReserve(listCopy, list->size)) {
+      BL_delete(listCopy);
+      return NULL;
+    }
+    if(list->size > 0) {
+      memcpy(listCopy->bits, list->bits, (list->size + 63) / 64 * sizeof(unsigned long long));
+    }
+    listCopy->size = list->size;
+    return listCopy;
+  }
+  BL *listCopy = BL_createPooled();
+  if(listCopy == NULL) {
+    return NULL;
+  }else if(!_BL_append(listCopy, NULL, list->start, list->size)) {
+    BL_delete(listCopy);
+    return NULL;
+  }
+  return listCopy;
+}
+
+bool BL_concatArray(BL *list, bool *array, int len) {
+  if(list->isPacked) {
+    if(len > 0 && !_BL_packedReserve(list, list->size + len)) {
+      return false;
+    }
+    for(int i = 0;i < len;i++) {
+      BL_add(list, array[i]);
+    }
+    return true;
+  }
+  return _BL_append(list, array, NULL, len);
+}
+
+bool BL_concatList(BL *listA, BL *listB) {
+  if(listA->isPacked) {
+    int size = listB->size;
+    if(size > 0 && !_BL_packedReserve(listA, listA->size + size)) {
+      return false;
+    }
+    for(int i = 0;i < size;i++) {
+      BL_add(listA, BL_get(listB, i));
+    }
+    return true;
+  }else if(listB->isPacked) {
+    bool *array = BL_toBoolArray(listB);
+    if(array == NULL && listB->size > 0) {
+      return false;
+    }
+    bool isDone = _BL_append(listA, array, NULL, listB->size);
+    STF_free(array);
+    return isDone;
+  }
+  return _BL_append(listA, NULL, listB->start, listB->size);
+}
+static bool _BL_canSplice(BL *list, BL *other) {
+  // a view borrows the nodes of its list and a copied header shares them, moving them would free them twice
+  return list != other && !list->isView && !other->isView && (list->pool == NULL || list->pool != other->pool) &&
+    (other->start == NULL || other->start != list->start);
+}
+
+bool BL_spliceAt(BL *list, int index, BL *other) {
+  if(index < 0 || index > list->size || !_BL_canSplice(list, other)) {
+    return false;
+  }else if(other->size == 0) {
+    return true;
+  }else if((list->isPacked && !BL_unpack(list)) || (other->isPacked && !BL_unpack(other))) {
+    return false;
+  }
+  BN *first = other->start, *last = other->end;
+  int size = other->size;
+  if(list->pool != other->pool && list->pool != NULL && other->pool != NULL && list->pool->arena == other->pool->arena &&
+    list->pool->allocator == other->pool->allocator) {
+    STF_Pool_merge(list->pool, other->pool);
+  }else if(list->pool != other->pool) {
+    // the nodes come from different allocators and can't change owner so copy them
+    BL tmpList = {.pool = list->pool};
+    if(!_BL_append(&tmpList, NULL, other->start, other->size)) {
+      return false;
+    }
+    BL_clear(other);
+    first = tmpList.start;
+    last = tmpList.end;
+  }
+  if(index == 0) {
+    last->next = list->start;
+    list->start = first;
+  }else {
+    BN *previousNode = BL_getNode(list, index - 1);
+    last->next = previousNode->next;
+    previousNode->next = first;
+  }
+  if(index == list->size) {
+    list->end = last;
+  }
+  list->size += size;
+  list->isIndexed = false;
+  other->start = other->end = NULL;
+  other->size = 0;
+  other->isIndexed = false;
+  return true;
+}
+
+bool BL_concatListMove(BL *listA, BL *listB) {
+  return BL_spliceAt(listA, listA->size, listB);
+}
+
+
+bool BL_reverse(BL *list) {
+  return BL_reverseRange(list, 0, list->size);
+}
+
+bool BL_reverseRange(BL *list, int start, int end) {
+  if(list->isPacked && !BL_unpack(list)) {
+    return false;
+  }
+  if(start < 0 || end > list->size || start > end) {
+    return false;
+  }else if(end - start < 2) {
+    return true;
+  }
+  BN *previousNode = start == 0 ? NULL : BL_getNode(list, start - 1);
+  BN *first = previousNode == NULL ? list->start : previousNode->next;
+  BN *tmpNode = first, *reversed = NULL;
+  for(int i = start;i < end;i++) {
+    BN *nextNode = tmpNode->next;
+    tmpNode->next = reversed;
+    reversed = tmpNode;
+    tmpNode = nextNode;
+  }
+  first->next = tmpNode;
+  if(previousNode == NULL) {
+    list->start = reversed;
+  }else {
+    previousNode->next = reversed;
+  }
+  if(end == list->size) {
+    list->end = first;
+  }
+  if(list->isIndexed) {
+    BN **left = list->nodes + list->offset + start, **right = list->nodes + list->offset + end - 1;
+    while(left < right) {
+      BN *swapNode = *left;
+      *left++ = *right;
+      *right-- = swapNode;
+    }
+  }
+  return true;
+}
+
+BL * BL_slice(BL *list, int start, int end) {
+  if(start >= list->size || start < 0 || end <= start) {
+    return NULL;
+  }
+  if(list->isPacked) {
+    BL *newBL = BL_createPacked();
+    for(int i = start;newBL != NULL && i < end && i < list->size;i++) {
+      if(!BL_add(newBL, BL_get(list, i))) {
+        BL_delete(newBL);
+        return NULL;
+      }
+    }
+    return newBL;
+  }
+  BL view = BL_view(list, start, end > list->size ? list->size : end);
+  return BL_copy(&view);
+}
+
+BL BL_view(BL *list, int start, int end) {
+  BL view = {.isView = true};
+  // the bits of a packed list aren't nodes a view could borrow
+  if(start < 0 || end > list->size || start >= end || list->isPacked) {
+    return view;
+  }
+  view.start = BL_getNode(list, start);
+  view.end = BL_getNode(list, end - 1);
+  view.size = end - start;
+  if(list->isIndexed) {
+    view.nodes = list->nodes + list->offset + start;
+    view.capacity = view.size;
+    view.isIndexed = true;
+  }
+  return view;
+}
+
+BL * BL_sub(BL *list, int start, int length) {
+  if(start >= list->size || start < 0 || length < 1) {
+    return NULL;
+  }
+  return BL_slice(list, start, length > list->size - start ? list->size : start + length);
+}
+
+bool BL_startsWith(BL *list, bool v) {
+  if(list->isPacked) {
+    return list->size > 0 && BL_get(list, 0) == v;
+  }
+  return list->size > 0 && list->start->value == v;
+}
+
+bool BL_endsWith(BL *list, bool v) {
+  if(list->isPacked) {
+    return list->size > 0 && BL_get(list, list->size - 1) == v;
+  }
+  return list->size == 1 && list->start->value == v ||
+    list->size > 0 && list->end->value == v;
+}
+
+bool BL_contains(BL *list, bool v) {
+  return BL_indexOf(list, v) != -1;
+}
+
+bool BL_isEmpty(BL *list) {
+  return list->size == 0 ? 1 : 0;
+}
+
+int BL_compare(BL *listA, BL *listB) {
+  int len = listA->size > listB->size ? listB->size : listA->size;
+  if(listA->isPacked || listB->isPacked) {
+    for(int i = 0;i < len;i++) {
+      bool a = BL_get(listA, i), b = BL_get(listB, i);
+      if(a != b) {
+        return a < b ? 1 : -1;
+      }
+    }
+  }else {
+    BN *tmpNodeA = listA->start;
+    BN *tmpNodeB = listB->start;
+    for(int i = 0;i < len;i++) {
+      if(tmpNodeA->value < tmpNodeB->value) {
+        return 1;
+      }else if(tmpNodeA->value > tmpNodeB->value) {
+        return -1;
+      }
+      tmpNodeA = tmpNodeA->next;
+      tmpNodeB = tmpNodeB->next;
+    }
   }
   if(listA->size > listB->size) return -1;
   else if(listA->size < listB->size) return 1;
@@ -436,6 +1546,14 @@ bool BL_equalsArray(BL *list, bool *array, int len) {
   if(list->size != len) {
     return false;
   }
+  if(list->isPacked) {
+    for(int i = 0;i < list->size;i++) {
+      if(BL_get(list, i) != array[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
   BN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
     if(tmpNode->value != array[i]) {
@@ -450,18 +1568,52 @@ bool BL_isSame(BL *listA, BL *listB) {
   return listA == listB;
 }
 
+static int _BL_scan(BL *list, bool v, bool isCounted) {
+  STF_SCAN(BN, list, v, isCounted);
+}
+
 int BL_indexOf(BL *list, bool v) {
-  BN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      return i;
+  if(list->isPacked) {
+    for(int i = 0, wordCount = (list->size + 63) / 64;i < wordCount;i++) {
+      unsigned long long word = v ? list->bits[i] : ~list->bits[i];
+      if(i == wordCount - 1 && list->size % 64 != 0) {
+        word &= (1ULL << list->size % 64) - 1;
+      }
+      if(word != 0) {
+        // the bits below the lowest set one, counted, give its position
+        return i * 64 + STF_popcount((word & -word) - 1);
+      }
     }
-    tmpNode = tmpNode->next;
+    return -1;
   }
-  return -1;
+  return _BL_scan(list, v, false);
 }
 
 int BL_lastIndexOf(BL *list, bool v) {
+  if(list->isPacked) {
+    for(int i = (list->size + 63) / 64 - 1;i >= 0;i--) {
+      unsigned long long word = v ? list->bits[i] : ~list->bits[i];
+      if(i == list->size / 64) {
+        word &= (1ULL << list->size % 64) - 1;
+      }
+      if(word != 0) {
+        int bit = 63;
+        while((word >> bit & 1) == 0) {
+          bit--;
+        }
+        return i * 64 + bit;
+      }
+    }
+    return -1;
+  }
+  if(list->isIndexed || _BL_index(list)) {
+    for(int i = list->size - 1;i >= 0;i--) {
+      if(list->nodes[list->offset + i]->value == v) {
+        return i;
+      }
+    }
+    return -1;
+  }
   BN *tmpNode = list->start;
   int index = -1;
   for(int i = 0;i < list->size;i++) {
@@ -474,18 +1626,24 @@ int BL_lastIndexOf(BL *list, bool v) {
 }
 
 int BL_count(BL *list, bool v) {
-  BN *tmpNode = list->start;
-  int n = 0;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      n++;
+  if(list->isPacked) {
+    int n = 0;
+    for(int i = 0, wordCount = (list->size + 63) / 64;i < wordCount;i++) {
+      n += STF_popcount(list->bits[i]);
     }
-    tmpNode = tmpNode->next;
+    return v ? n : list->size - n;
   }
-  return n;
+  return _BL_scan(list, v, true);
 }
 
 void BL_fill(BL *list, bool v) {
+  if(list->isPacked) {
+    if(list->size > 0) {
+      memset(list->bits, v ? 0xFF : 0, (list->size + 63) / 64 * sizeof(unsigned long long));
+      _BL_maskTail(list);
+    }
+    return;
+  }
   BN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
     tmpNode->value = v;
@@ -494,6 +1652,13 @@ void BL_fill(BL *list, bool v) {
 }
 
 void BL_replace(BL *list, bool oldValue, bool newValue) {
+  // with two values, replacing one by the other leaves only the new one
+  if(list->isPacked) {
+    if(oldValue != newValue) {
+      BL_fill(list, newValue);
+    }
+    return;
+  }
   BN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
     if(tmpNode->value == oldValue) {
@@ -502,19 +1667,59 @@ void BL_replace(BL *list, bool oldValue, bool newValue) {
     tmpNode = tmpNode->next;
   }
 }
+bool BL_and(BL *listA, BL *listB) {
+  return _BL_combineBits(listA, listB, '&');
+}
+
+bool BL_or(BL *listA, BL *listB) {
+  return _BL_combineBits(listA, listB, '|');
+}
+
+bool BL_xor(BL *listA, BL *listB) {
+  return _BL_combineBits(listA, listB, '^');
+}
+
+void BL_not(BL *list) {
+  if(list->isPacked) {
+    for(int i = 0, wordCount = (list->size + 63) / 64;i < wordCount;i++) {
+      list->bits[i] = ~list->bits[i];
+    }
+    _BL_maskTail(list);
+    return;
+  }
+  BN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    tmpNode->value = !tmpNode->value;
+    tmpNode = tmpNode->next;
+  }
+}
+
 
 void BL_print(BL *list) {
   BN *tmpNode = list->start;
   printf("{");
   for(int i = 0;i < list->size;i++) {
-    printf("%s", tmpNode->value ? "true" : "false");
-    tmpNode = tmpNode->next;
+    if(list->isPacked) {
+      printf("%s", BL_get(list, i) ? "true" : "false");
+    }else {
+      printf("%s", tmpNode->value ? "true" : "false");
+      tmpNode = tmpNode->next;
+    }
     i != list->size - 1 && printf(", ");
   }
   printf("}");
 }
 
 void BL_forEach(BL *list, void (*cb)(BL *, BN *, int)) {
+  if(list->isPacked) {
+    // the callback gets a node holding a copy of the bit, which is written back after it
+    for(int i = 0;i < list->size;i++) {
+      BN boolNode = {BL_get(list, i), NULL};
+      cb(list, &boolNode, i);
+      BL_set(list, boolNode.value, i);
+    }
+    return;
+  }
   BN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
     cb(list, tmpNode, i);
@@ -522,11 +1727,37 @@ void BL_forEach(BL *list, void (*cb)(BL *, BN *, int)) {
   }
 }
 
+void BL_forEachReverse(BL *list, void (*cb)(BL *, BN *, int)) {
+  if(list->isPacked) {
+    for(int i = list->size - 1;i >= 0;i--) {
+      BN boolNode = {BL_get(list, i), NULL};
+      cb(list, &boolNode, i);
+      BL_set(list, boolNode.value, i);
+    }
+    return;
+  }
+  for(int i = list->size - 1;i >= 0;i--) {
+    cb(list, BL_getNode(list, i), i);
+  }
+}
+
 BL * BL_map(BL *list, bool (*cb)(BL *, BN *, int)) {
   BL *newBL = BL_create();
   if(newBL == NULL) {
     return NULL;
   }  
+  if(list->isPacked) {
+    for(int i = 0;i < list->size;i++) {
+      BN boolNode = {BL_get(list, i), NULL};
+      bool v = cb(list, &boolNode, i);
+      BL_set(list, boolNode.value, i);
+      if(!BL_add(newBL, v)) {
+        BL_delete(newBL);
+        return NULL;
+      }
+    }
+    return newBL;
+  }
   BN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
     if(!BL_add(newBL, cb(list, tmpNode, i))) {
@@ -543,6 +1774,18 @@ BL * BL_filter(BL *list, bool (*cb)(BL *, BN *, int)) {
   if(newBL == NULL) {
     return NULL;
   }
+  if(list->isPacked) {
+    for(int i = 0;i < list->size;i++) {
+      BN boolNode = {BL_get(list, i), NULL};
+      bool isKept = cb(list, &boolNode, i);
+      BL_set(list, boolNode.value, i);
+      if(isKept && !BL_add(newBL, boolNode.value)) {
+        BL_delete(newBL);
+        return NULL;
+      }
+    }
+    return newBL;
+  }
   BN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
     if(!cb(list, tmpNode, i)) {
@@ -559,6 +1802,17 @@ BL * BL_filter(BL *list, bool (*cb)(BL *, BN *, int)) {
 }
 
 bool BL_every(BL *list, bool (*cb)(BL *, BN *, int)) {
+  if(list->isPacked) {
+    for(int i = 0;i < list->size;i++) {
+      BN boolNode = {BL_get(list, i), NULL};
+      bool isPassed = cb(list, &boolNode, i);
+      BL_set(list, boolNode.value, i);
+      if(!isPassed) {
+        return false;
+      }
+    }
+    return true;
+  }
   BN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
     if(!cb(list, tmpNode, i)) {
@@ -568,6 +1822,107 @@ bool BL_every(BL *list, bool (*cb)(BL *, BN *, int)) {
   }
   return true;
 }
+BL_Iter BL_iterBegin(BL *list) {
+  BL_Iter iter = {list, NULL, -1};
+  return iter;
+}
+
+static bool _BL_iterUnpack(BL_Iter *iter) {
+  if(!iter->list->isPacked) {
+    return true;
+  }else if(!BL_unpack(iter->list)) {
+    return false;
+  }
+  if(iter->index >= 0 && iter->index < iter->list->size) {
+    iter->node = BL_getNode(iter->list, iter->index);
+  }
+  return true;
+}
+
+bool BL_iterNext(BL_Iter *iter) {
+  if(iter->list->isPacked) {
+    // the bits are read in place, only index moves
+    if(iter->index < iter->list->size) {
+      iter->index++;
+    }
+    return iter->index < iter->list->size;
+  }
+  if(iter->index == -1) {
+    iter->node = iter->list->start;
+  }else if(iter->node != NULL) {
+    iter->node = iter->node->next;
+  }else {
+    return false;
+  }
+  iter->index++;
+  return iter->node != NULL;
+}
+
+bool BL_iterValue(BL_Iter *iter) {
+  if(iter->list->isPacked) {
+    return BL_get(iter->list, iter->index);
+  }
+  return iter->node == NULL ? false : iter->node->value;
+}
+
+bool BL_iterSet(BL_Iter *iter, bool v) {
+  if(iter->list->isPacked) {
+    return BL_set(iter->list, v, iter->index);
+  }else if(iter->node == NULL) {
+    return false;
+  }
+  iter->node->value = v;
+  return true;
+}
+
+bool BL_iterInsertAfter(BL_Iter *iter, bool v) {
+  if(!_BL_iterUnpack(iter)) {
+    return false;
+  }
+  if(iter->node == NULL && iter->index != -1) {
+    return false;
+  }
+  BN *boolNode = BN_create(iter->list->pool, v);
+  if(boolNode == NULL) {
+    return false;
+  }
+  if(iter->node == NULL) {
+    boolNode->next = iter->list->start;
+    iter->list->start = boolNode;
+  }else {
+    boolNode->next = iter->node->next;
+    iter->node->next = boolNode;
+  }
+  if(boolNode->next == NULL) {
+    iter->list->end = boolNode;
+  }
+  _BL_indexInsert(iter->list, boolNode, iter->index + 1);
+  iter->list->size++;
+  return true;
+}
+
+bool BL_iterRemoveNext(BL_Iter *iter) {
+  if(!_BL_iterUnpack(iter)) {
+    return false;
+  }
+  BN *tmpNode = iter->node == NULL ? iter->list->start : iter->node->next;
+  if(tmpNode == NULL || (iter->node == NULL && iter->index != -1)) {
+    return false;
+  }
+  if(iter->node == NULL) {
+    iter->list->start = tmpNode->next;
+  }else {
+    iter->node->next = tmpNode->next;
+  }
+  if(tmpNode == iter->list->end) {
+    iter->list->end = iter->node;
+  }
+  _BL_indexRemove(iter->list, iter->index + 1);
+  iter->list->size--;
+  BN_delete(iter->list->pool, tmpNode);
+  return true;
+}
+
 
 /*----------------######################################################################----------------*/
 /*----------------#-- **** --**  **-- **** --******----**    --******--******--******--#----------------*/
@@ -580,8 +1935,8 @@ bool BL_every(BL *list, bool (*cb)(BL *, BN *, int)) {
 /*----------------#-- **** --**  **--**  **--**  **----******--******--******--  **  --#----------------*/
 /*----------------######################################################################----------------*/
 
-static CN * CN_create(char v) {
-  CN *charNode = (CN *)malloc(sizeof(CN));
+static CN * CN_create(STF_Pool *pool, char v) {
+  CN *charNode = (CN *)(pool == NULL ? STF_malloc(sizeof(CN)) : STF_Pool_alloc(pool));
   if(charNode == NULL) {
     return NULL;
   }
@@ -590,56 +1945,337 @@ static CN * CN_create(char v) {
   return charNode;
 }
 
+static void CN_delete(STF_Pool *pool, CN *charNode) {
+  if(pool == NULL) {
+    STF_release(charNode);
+  }else {
+    STF_Pool_free(pool, charNode);
+  }
+}
+
 static CN * CL_getNode(CL * list, int index) {
   if(index < 0 || index >= list->size) {
     return NULL;
   }
+  if(list->isIndexed || _CL_index(list)) {
+    return list->nodes[list->offset + index];
+  }
+  CN *tmpNode = list->start;
+  for(int i = 0;i < index;i++) {
+    tmpNode = tmpNode->next;
+  }
+  return tmpNode;
+}
+
+static bool _CL_reserve(CL *list, int capacity) {
+  if(list->offset + capacity <= list->capacity) {
+    return true;
+  }
+  // slide the table back to the beginning before growing it
+  if(list->isIndexed && list->offset > 0) {
+    memmove(list->nodes, list->nodes + list->offset, list->size * sizeof(CN *));
+  }
+  list->offset = 0;
+  if(capacity <= list->capacity) {
+    return true;
+  }
+  int newCapacity = list->capacity == 0 ? 16 : list->capacity;
+  while(newCapacity < capacity) {
+    newCapacity *= 2;
+  }
+  CN **nodes = (CN **)STF_reallocWith(STF_Pool_allocator(list->pool), list->nodes, newCapacity * sizeof(CN *));
+  if(nodes == NULL) {
+    return false;
+  }
+  list->nodes = nodes;
+  list->capacity = newCapacity;
+  return true;
+}
+
+static bool _CL_index(CL *list) {
+  // a view shares the nodes of another list and never owns a table
+  if(list->isView) {
+    return false;
+  }
+  list->offset = 0;
+  if(!_CL_reserve(list, list->size)) {
+    return false;
+  }
   CN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(i == index) {
-      return tmpNode;
-    }
+    list->nodes[i] = tmpNode;
     tmpNode = tmpNode->next;
   }
+  list->isIndexed = true;
+  return true;
+}
+
+static void _CL_indexInsert(CL *list, CN *node, int index) {
+  if(!list->isIndexed) {
+    return;
+  }
+  if(index < list->size / 2 && list->offset > 0) {
+    list->offset--;
+    memmove(list->nodes + list->offset, list->nodes + list->offset + 1, index * sizeof(CN *));
+  }else if(index == 0) {
+    // no room in front of the table, it's cheaper to rebuild it when needed
+    list->isIndexed = false;
+    return;
+  }else {
+    if(!_CL_reserve(list, list->size + 1)) {
+      list->isIndexed = false;
+      return;
+    }
+    memmove(list->nodes + list->offset + index + 1, list->nodes + list->offset + index,
+      (list->size - index) * sizeof(CN *));
+  }
+  list->nodes[list->offset + index] = node;
+}
+
+static void _CL_indexRemove(CL *list, int index) {
+  if(!list->isIndexed || index >= list->size) {
+    return;
+  }
+  if(index < list->size / 2) {
+    memmove(list->nodes + list->offset + 1, list->nodes + list->offset, index * sizeof(CN *));
+    list->offset++;
+  }else {
+    memmove(list->nodes + list->offset + index, list->nodes + list->offset + index + 1,
+      (list->size - index - 1) * sizeof(CN *));
+  }
+}
+
+static void _CL_sortNodes(CL *list, bool isReversed) {
+  if(list->size < 2) {
+    return;
+  }
+  CN *start = list->start, *tail = NULL;
+  for(int width = 1;width < list->size;width *= 2) {
+    CN *left = start;
+    start = tail = NULL;
+    while(left != NULL) {
+      CN *right = left;
+      int leftSize = 0, rightSize = width;
+      while(leftSize < width && right != NULL) {
+        right = right->next;
+        leftSize++;
+      }
+      while(leftSize > 0 || (rightSize > 0 && right != NULL)) {
+        CN *tmpNode;
+        if(leftSize == 0 || (rightSize > 0 && right != NULL &&
+            (isReversed ? left->value < right->value : left->value > right->value))) {
+          tmpNode = right;
+          right = right->next;
+          rightSize--;
+        }else {
+          tmpNode = left;
+          left = left->next;
+          leftSize--;
+        }
+        if(tail == NULL) {
+          start = tmpNode;
+        }else {
+          tail->next = tmpNode;
+        }
+        tail = tmpNode;
+      }
+      left = right;
+    }
+    tail->next = NULL;
+  }
+  list->start = start;
+  list->end = tail;
+  list->isIndexed = false;
 }
 
 static void _CL_sort(CL *list, bool isReversed) {
-  CN *currentNode, *previousNode;
-  bool difference;
-  loopAgain:
-    difference = false;
-    currentNode = previousNode = list->start;
-    for(int i = 0;i < list->size;i++) {
-      currentNode = currentNode->next;
-      if(currentNode != NULL && (isReversed ? previousNode->value < currentNode->value :
-          previousNode->value > currentNode->value)) {
-        char v = currentNode->value;
-        currentNode->value = previousNode->value;
-        previousNode->value = v;
-        difference = true;
+  if(list->size < STF_SORT_CUTOFF) {
+    _CL_sortNodes(list, isReversed);
+    return;
+  }
+  int counts[UCHAR_MAX + 1] = {0};
+  CN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    counts[tmpNode->value - CHAR_MIN]++;
+    tmpNode = tmpNode->next;
+  }
+  tmpNode = list->start;
+  for(int i = 0;i <= UCHAR_MAX;i++) {
+    int bucket = isReversed ? UCHAR_MAX - i : i;
+    for(int n = counts[bucket];n > 0;n--) {
+      tmpNode->value = (char)(bucket + CHAR_MIN);
+      tmpNode = tmpNode->next;
+    }
+  }
+}
+
+static bool _CL_append(CL *list, String array, CN *source, int len) {
+  if(len <= 0) {
+    return true;
+  }else if(list->pool != NULL && !STF_Pool_reserve(list->pool, len)) {
+    return false;
+  }
+  CN *first = NULL, *last = NULL;
+  bool isOrdered = true;
+  for(int i = 0;i < len;i++) {
+    CN *charNode = CN_create(list->pool, array != NULL ? array[i] : source->value);
+    if(charNode == NULL) {
+      while(first != NULL) {
+        CN *tmpNode = first->next;
+        CN_delete(list->pool, first);
+        first = tmpNode;
       }
-      previousNode = currentNode;
+      return false;
+    }
+    if(last == NULL ? list->size > 0 && charNode->value < list->end->value : charNode->value < last->value) {
+      isOrdered = false;
+    }
+    if(first == NULL) {
+      first = charNode;
+    }else {
+      last->next = charNode;
+    }
+    last = charNode;
+    if(array == NULL) {
+      source = source->next;
+    }
+  }
+  if(list->size == 0) {
+    list->start = first;
+  }else {
+    list->end->next = first;
+  }
+  list->end = last;
+  if(list->isIndexed && _CL_reserve(list, list->size + len)) {
+    CN **nodes = list->nodes + list->offset + list->size;
+    for(CN *tmpNode = first;tmpNode != NULL;tmpNode = tmpNode->next) {
+      *nodes++ = tmpNode;
     }
-  if(difference) {
-    goto loopAgain;
+  }else {
+    list->isIndexed = false;
   }
+  list->size += len;
+  list->isSorted = list->isSorted && isOrdered;
+  return true;
 }
 
 CL * CL_create() {
-  CL *list = (CL *)malloc(sizeof(CL));
+  CL *list = (CL *)STF_malloc(sizeof(CL));
+  if(list == NULL) {
+    return NULL;
+  }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->pool = NULL;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->isView = false;
+  list->isSorted = true;
+  return list;
+}
+
+CL * CL_createPooled() {
+  CL *list = CL_create();
+  if(list == NULL) {
+    return NULL;
+  }
+  list->pool = STF_Pool_create(sizeof(CN));
+  if(list->pool == NULL) {
+    STF_release(list);
+    return NULL;
+  }
+  return list;
+}
+
+CL * CL_createIn(STF_Arena *arena) {
+  CL *list = (CL *)STF_Arena_alloc(arena, sizeof(CL));
+  if(list == NULL) {
+    return NULL;
+  }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->isView = false;
+  list->isSorted = true;
+  // the list is only tracked once it can be deleted like any arena list
+  list->pool = STF_Pool_createIn(arena, NULL, sizeof(CN));
+  if(list->pool == NULL || !_STF_Arena_track(arena, list, 'C')) {
+    return NULL;
+  }
+  return list;
+}
+
+CL * CL_createWith(const STF_Allocator *allocator) {
+  CL *list = (CL *)STF_allocWith(allocator, sizeof(CL));
   if(list == NULL) {
     return NULL;
   }
   list->start = list->end = NULL;
   list->size = 0;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->isView = false;
+  list->isSorted = true;
+  list->pool = STF_Pool_createIn(NULL, allocator, sizeof(CN));
+  if(list->pool == NULL) {
+    STF_freeWith(allocator, list);
+    return NULL;
+  }
   return list;
 }
 
+bool CL_compact(CL *list) {
+  if(list->isView) {
+    return false;
+  }else if(list->size == 0) {
+    return true;
+  }
+  STF_Pool *pool = STF_Pool_createLike(list->pool, sizeof(CN));
+  if(pool == NULL || !STF_Pool_grow(pool, list->size)) {
+    STF_Pool_delete(pool);
+    return false;
+  }
+  CN *tmpNode = list->start, *lastNode = NULL;
+  for(int i = 0;i < list->size;i++) {
+    CN *newNode = (CN *)STF_Pool_alloc(pool);
+    *newNode = *tmpNode;
+    if(lastNode == NULL) {
+      list->start = newNode;
+    }else {
+      lastNode->next = newNode;
+    }
+    if(list->isIndexed) {
+      list->nodes[list->offset + i] = newNode;
+    }
+    lastNode = newNode;
+    CN *nextNode = tmpNode->next;
+    if(list->pool == NULL) {
+      STF_release(tmpNode);
+    }
+    tmpNode = nextNode;
+  }
+  list->end = lastNode;
+  // every node of a pooled list lives in its chunks, so the old pool can go at once
+  STF_Pool_delete(list->pool);
+  list->pool = pool;
+  return true;
+}
+
 bool CL_add(CL *list, char v) {
-  CN *charNode = CN_create(v);
+  CN *charNode = CN_create(list->pool, v);
   if(charNode == NULL) {
     return false;
   }
+  if(list->size > 0 && v < list->end->value) {
+    list->isSorted = false;
+  }
   if(list->size == 0) {
     list->start = list->end = charNode;
   }else if(list->size == 1) {
@@ -648,15 +2284,19 @@ bool CL_add(CL *list, char v) {
     list->end->next = charNode;
     list->end = list->end->next;
   }
+  _CL_indexInsert(list, charNode, list->size);
   list->size++;
   return true;
 }
 
 bool CL_unshift(CL * list, char v) {
-  CN *charNode = CN_create(v);
+  CN *charNode = CN_create(list->pool, v);
   if(charNode == NULL) {
     return false;
   }
+  if(list->size > 0 && v > list->start->value) {
+    list->isSorted = false;
+  }
   if(list->size == 0) {
     list->start = list->end = charNode;
   }else if(list->size == 1) {
@@ -667,6 +2307,7 @@ bool CL_unshift(CL * list, char v) {
     list->start = charNode;
     list->start->next = tmpNode;
   }
+  _CL_indexInsert(list, charNode, 0);
   list->size++;
   return true;
 }
@@ -675,19 +2316,21 @@ char CL_pop(CL *list) {
   char v = '\0';
   if(list->size > 2) {
     v = list->end->value;
-    free(list->end);
-    list->end = CL_getNode(list, list->size - 2);
+    CN *previousNode = CL_getNode(list, list->size - 2);
+    CN_delete(list->pool, list->end);
+    list->end = previousNode;
     list->end->next = NULL;
     list->size--;
   }else if(list->size == 2) {
     v = list->end->value;
-    free(list->end);
-    list->start->next = list->end = NULL;
+    CN_delete(list->pool, list->end);
+    list->start->next = NULL;
+    list->end = list->start;
     list->size = 1;
   }else if(list->size == 1) {
     v = list->start->value;
-    free(list->start);
-    list->start = NULL;
+    CN_delete(list->pool, list->start);
+    list->start = list->end = NULL;
     list->size = 0;
   }
   return v;
@@ -695,16 +2338,17 @@ char CL_pop(CL *list) {
 
 char CL_shift(CL * list) {
   char v = '\0';
+  _CL_indexRemove(list, 0);
   if(list->size > 1) {
     CN *tmpNode = list->start->next;
     v = list->start->value;
-    free(list->start);
+    CN_delete(list->pool, list->start);
     list->start = tmpNode;
     list->size--;
   }else if(list->size == 1) {
     v = list->start->value;
-    free(list->start);
-    list->start = NULL;
+    CN_delete(list->pool, list->start);
+    list->start = list->end = NULL;
     list->size = 0;
   }
   return v;
@@ -720,10 +2364,14 @@ bool CL_insert(CL *list, char v, int index) {
     if(!CL_add(list, v)) return false;
   }else {
     CN *previousNode = CL_getNode(list, index - 1);
-    CN *currentNode = CN_create(v);
+    CN *currentNode = CN_create(list->pool, v);
     if(currentNode == NULL) return false;
+    if(v < previousNode->value || v > previousNode->next->value) {
+      list->isSorted = false;
+    }
     currentNode->next = previousNode->next;
     previousNode->next = currentNode;
+    _CL_indexInsert(list, currentNode, index);
     list->size++;
   }
   return true;
@@ -741,7 +2389,8 @@ char CL_remove(CL *list, int index) {
       CN *charNode = previousCN->next;
       v = charNode->value;
       previousCN->next = charNode->next;
-      free(charNode);
+      CN_delete(list->pool, charNode);
+      _CL_indexRemove(list, index);
       list->size--;
     }
   }
@@ -749,45 +2398,61 @@ char CL_remove(CL *list, int index) {
 }
 
 void CL_clear(CL *list) {
-  for(int i = 0, size = list->size;i < size;i++) {
-    CL_shift(list);
+  if(list->isView) {
+    // a view doesn't own its nodes, they stay with the list it was made from
+  }else if(list->pool != NULL) {
+    STF_Pool_reset(list->pool);
+  }else {
+    CN *tmpNode = list->start;
+    for(int i = 0;i < list->size;i++) {
+      CN *nextNode = tmpNode->next;
+      STF_release(tmpNode);
+      tmpNode = nextNode;
+    }
   }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->offset = 0;
+  list->isSorted = true;
 }
 
 void CL_delete(CL *list) {
+  // a list made in an arena keeps its header until the arena is reset
+  bool isInArena = list->pool != NULL && list->pool->arena != NULL;
+  const STF_Allocator *allocator = STF_Pool_allocator(list->pool);
   CL_clear(list);
-  free(list);
+  STF_Pool_delete(list->pool);
+  STF_freeWith(allocator, list->nodes);
+  if(isInArena) {
+    list->nodes = NULL;
+    list->capacity = 0;
+    list->isIndexed = false;
+    return;
+  }
+  STF_freeWith(allocator, list);
 }
 
 bool CL_set(CL * list, char v, int index) {
-  if(index >= 0 && index < list->size) {
-    CN *tmpNode = list->start;
-    for(int i = 0;i < list->size;i++) {
-      if(i == index) {
-        tmpNode->value = v;
-        return true;
-      }
-      tmpNode = tmpNode->next;
-    }
+  CN *tmpNode = CL_getNode(list, index);
+  if(tmpNode == NULL) {
+    return false;
   }
-  return false;
+  tmpNode->value = v;
+  list->isSorted = false;
+  return true;
 }
 
 char CL_get(CL * list, int index) {
-  if(index < 0 || index >= list->size) {
-    return '\0';
-  }
-  CN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i == index) {
-      return tmpNode->value;
-    }
-    tmpNode = tmpNode->next;
-  }
+  CN *tmpNode = CL_getNode(list, index);
+  return tmpNode == NULL ? '\0' : tmpNode->value;
 }
 
 String CL_toCharArray(CL *list) {
-  String array = (String)malloc(list->size + 1);
+  return _CL_chars(list, true);
+}
+
+static String _CL_chars(CL *list, bool isOut) {
+  String array = (String)(isOut ? STF_mallocOut(list->size + 1) : STF_malloc(list->size + 1));
   if(array == NULL) {
     return NULL;
   }
@@ -801,22 +2466,29 @@ String CL_toCharArray(CL *list) {
 }
 
 void CL_toLowerCase(CL *list) {
+  list->isSorted = false;
+  unsigned char table[256];
+  STF_caseTable(table, false);
   CN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    tmpNode->value = tolower(tmpNode->value);
+    tmpNode->value = table[(unsigned char)tmpNode->value];
     tmpNode = tmpNode->next;
   }
 }
 
 void CL_toUpperCase(CL *list) {
+  list->isSorted = false;
+  unsigned char table[256];
+  STF_caseTable(table, true);
   CN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    tmpNode->value = toupper(tmpNode->value);
+    tmpNode->value = table[(unsigned char)tmpNode->value];
     tmpNode = tmpNode->next;
   }
 }
 
 void CL_capitalize(CL *list) {
+  list->isSorted = false;
   if(list->size > 0) {
     list->start->value = toupper(list->start->value);
   }
@@ -824,84 +2496,179 @@ void CL_capitalize(CL *list) {
 
 void CL_sort(CL *list) {
   _CL_sort(list, false);
+  list->isSorted = true;
 }
 
 void CL_rsort(CL *list) {
   _CL_sort(list, true);
+  list->isSorted = false;
+}
+static int _CL_bound(CL *list, char v, bool isUpper) {
+  if(!list->isIndexed && !_CL_index(list)) {
+    CN *tmpNode = list->start;
+    int index = 0;
+    while(index < list->size && (isUpper ? tmpNode->value <= v : tmpNode->value < v)) {
+      tmpNode = tmpNode->next;
+      index++;
+    }
+    return index;
+  }
+  CN **nodes = list->nodes + list->offset;
+  int low = 0, high = list->size;
+  while(low < high) {
+    int middle = low + (high - low) / 2;
+    if(isUpper ? nodes[middle]->value <= v : nodes[middle]->value < v) {
+      low = middle + 1;
+    }else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+int CL_lowerBound(CL *list, char v) {
+  return _CL_bound(list, v, false);
+}
+
+int CL_upperBound(CL *list, char v) {
+  return _CL_bound(list, v, true);
+}
+
+int CL_binarySearch(CL *list, char v) {
+  int index = _CL_bound(list, v, false);
+  return index < list->size && CL_getNode(list, index)->value == v ? index : -1;
+}
+
+bool CL_sortedInsert(CL *list, char v) {
+  return CL_insert(list, v, _CL_bound(list, v, true));
 }
 
 CL * CL_createFrom(String array) {
-  CL *list = CL_create();
+  CL *list = CL_createPooled();
   if(list == NULL) {
     return NULL;
+  }else if(!_CL_append(list, array, NULL, strlen(array))) {
+    CL_delete(list);
+    return NULL;
   }
-  int i = 0;
-  while(array[i] != '\0') {
-    if(!CL_add(list, array[i])) {
-      CL_delete(list);
-      return NULL;
-    }
-    i++;
+  return list;
+}
+
+CL * CL_createFromIn(STF_Arena *arena, String array) {
+  CL *list = CL_createIn(arena);
+  if(list == NULL || !_CL_append(list, array, NULL, strlen(array))) {
+    return NULL;
   }
   return list;
 }
 
 CL * CL_copy(CL *list) {
-  CL *listCopy = CL_create();
+  CL *listCopy = CL_createPooled();
   if(listCopy == NULL) {
     return NULL;
-  }
-  CN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(!CL_add(listCopy, tmpNode->value)) {
-      CL_delete(listCopy);
-      return NULL;
-    }
-    tmpNode = tmpNode->next;
+  }else if(!_CL_append(listCopy, NULL, list->start, list->size)) {
+    CL_delete(listCopy);
+    return NULL;
   }
   return listCopy;
 }
 
 bool CL_concatArray(CL *list, String array) {
-  int i = 0;
-  while(array[i] != '\0') {
-    if(!CL_add(list, array[i])) {
-      return false;
-    }
-    i++;
-  }
-  return true;
+  return _CL_append(list, array, NULL, strlen(array));
 }
 
 bool CL_concatList(CL *listA, CL *listB) {
-  CN *tmpNode = listB->start;
-  for(int i = 0;i < listB->size;i++) {
-    if(!CL_add(listA, tmpNode->value)) {
+  return _CL_append(listA, NULL, listB->start, listB->size);
+}
+static bool _CL_canSplice(CL *list, CL *other) {
+  // a view borrows the nodes of its list and a copied header shares them, moving them would free them twice
+  return list != other && !list->isView && !other->isView && (list->pool == NULL || list->pool != other->pool) &&
+    (other->start == NULL || other->start != list->start);
+}
+
+bool CL_spliceAt(CL *list, int index, CL *other) {
+  if(index < 0 || index > list->size || !_CL_canSplice(list, other)) {
+    return false;
+  }else if(other->size == 0) {
+    return true;
+  }
+  CN *first = other->start, *last = other->end;
+  int size = other->size;
+  if(list->pool != other->pool && list->pool != NULL && other->pool != NULL && list->pool->arena == other->pool->arena &&
+    list->pool->allocator == other->pool->allocator) {
+    STF_Pool_merge(list->pool, other->pool);
+  }else if(list->pool != other->pool) {
+    // the nodes come from different allocators and can't change owner so copy them
+    CL tmpList = {.pool = list->pool};
+    if(!_CL_append(&tmpList, NULL, other->start, other->size)) {
       return false;
     }
-    tmpNode = tmpNode->next;
+    CL_clear(other);
+    first = tmpList.start;
+    last = tmpList.end;
   }
+  if(index == 0) {
+    last->next = list->start;
+    list->start = first;
+  }else {
+    CN *previousNode = CL_getNode(list, index - 1);
+    last->next = previousNode->next;
+    previousNode->next = first;
+  }
+  if(index == list->size) {
+    list->end = last;
+  }
+  list->size += size;
+  list->isIndexed = false;
+  list->isSorted = false;
+  other->start = other->end = NULL;
+  other->size = 0;
+  other->isIndexed = false;
   return true;
 }
 
+bool CL_concatListMove(CL *listA, CL *listB) {
+  return CL_spliceAt(listA, listA->size, listB);
+}
+
+
 bool CL_reverse(CL *list) {
-  CL *tmpCL = CL_create();
-  if(tmpCL == NULL) {
+  return CL_reverseRange(list, 0, list->size);
+}
+
+bool CL_reverseRange(CL *list, int start, int end) {
+  if(start < 0 || end > list->size || start > end) {
     return false;
+  }else if(end - start < 2) {
+    return true;
+  }
+  list->isSorted = false;
+  CN *previousNode = start == 0 ? NULL : CL_getNode(list, start - 1);
+  CN *first = previousNode == NULL ? list->start : previousNode->next;
+  CN *tmpNode = first, *reversed = NULL;
+  for(int i = start;i < end;i++) {
+    CN *nextNode = tmpNode->next;
+    tmpNode->next = reversed;
+    reversed = tmpNode;
+    tmpNode = nextNode;
+  }
+  first->next = tmpNode;
+  if(previousNode == NULL) {
+    list->start = reversed;
+  }else {
+    previousNode->next = reversed;
   }
-  CN *tmpNode = list->start;
-  for(int i = 0;i < list->size; i++) {
-    if(!CL_unshift(tmpCL, tmpNode->value)) {
-      CL_delete(tmpCL);
-      return false;
+  if(end == list->size) {
+    list->end = first;
+  }
+  if(list->isIndexed) {
+    CN **left = list->nodes + list->offset + start, **right = list->nodes + list->offset + end - 1;
+    while(left < right) {
+      CN *swapNode = *left;
+      *left++ = *right;
+      *right-- = swapNode;
     }
-    tmpNode = tmpNode->next;
   }
-  CL_clear(list);
-  list->start = tmpCL->start;
-  list->end = tmpCL->end;
-  list->size = tmpCL->size;
-  free(tmpCL);
   return true;
 }
 
@@ -909,48 +2676,31 @@ CL * CL_slice(CL *list, int start, int end) {
   if(start >= list->size || start < 0 || end <= start) {
     return NULL;
   }
-  CL *listSub = CL_create();
-  if(listSub == NULL) {
-    return NULL;
+  CL view = CL_view(list, start, end > list->size ? list->size : end);
+  return CL_copy(&view);
+}
+
+CL CL_view(CL *list, int start, int end) {
+  CL view = {.isView = true, .isSorted = list->isSorted};
+  if(start < 0 || end > list->size || start >= end) {
+    return view;
   }
-  CN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i >= start && i < end) {
-      if(!CL_add(listSub, tmpNode->value)) {
-        CL_delete(listSub);
-        return NULL;
-      }
-    }
-    if(i == end - 1) {
-      return listSub;
-    }
-    tmpNode = tmpNode->next;
+  view.start = CL_getNode(list, start);
+  view.end = CL_getNode(list, end - 1);
+  view.size = end - start;
+  if(list->isIndexed) {
+    view.nodes = list->nodes + list->offset + start;
+    view.capacity = view.size;
+    view.isIndexed = true;
   }
-  return listSub;
+  return view;
 }
 
 CL * CL_sub(CL *list, int start, int length) {
   if(start >= list->size || start < 0 || length < 1) {
     return NULL;
   }
-  CL *listSub = CL_create();
-  if(listSub == NULL) {
-    return NULL;
-  }
-  CN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i >= start && i < start + length) {
-      if(!CL_add(listSub, tmpNode->value)) {
-        CL_delete(listSub);
-        return NULL;
-      }
-    }
-    if(i > start + length - 1) {
-      return listSub;
-    }
-    tmpNode = tmpNode->next;
-  }
-  return listSub;
+  return CL_slice(list, start, length > list->size - start ? list->size : start + length);
 }
 
 bool CL_startsWith(CL *list, char v) {
@@ -962,14 +2712,7 @@ bool CL_endsWith(CL *list, char v) {
 }
 
 bool CL_contains(CL * list, char v) {
-  CN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      return true;
-    }
-    tmpNode = tmpNode->next;
-  }
-  return false;
+  return CL_indexOf(list, v) != -1;
 }
 
 bool CL_isEmpty(CL *list) {
@@ -1016,18 +2759,31 @@ bool CL_isSame(CL *listA, CL *listB) {
   return listA == listB;
 }
 
+static int _CL_scan(CL *list, char v, bool isCounted) {
+  STF_SCAN(CN, list, v, isCounted);
+}
+
 int CL_indexOf(CL * list, char v) {
-  CN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      return i;
-    }
-    tmpNode = tmpNode->next;
+  if(list->isSorted) {
+    int index = _CL_bound(list, v, false);
+    return index < list->size && CL_getNode(list, index)->value == v ? index : -1;
   }
-  return -1;
+  return _CL_scan(list, v, false);
 }
 
 int CL_lastIndexOf(CL * list, char v) {
+  if(list->isSorted) {
+    int index = _CL_bound(list, v, true) - 1;
+    return index >= 0 && CL_getNode(list, index)->value == v ? index : -1;
+  }
+  if(list->isIndexed || _CL_index(list)) {
+    for(int i = list->size - 1;i >= 0;i--) {
+      if(list->nodes[list->offset + i]->value == v) {
+        return i;
+      }
+    }
+    return -1;
+  }
   CN *tmpNode = list->start;
   int index = -1;
   for(int i = 0;i < list->size;i++) {
@@ -1040,15 +2796,10 @@ int CL_lastIndexOf(CL * list, char v) {
 }
 
 int CL_count(CL *list, char v) {
-  CN *tmpNode = list->start;
-  int n = 0;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      n++;
-    }
-    tmpNode = tmpNode->next;
+  if(list->isSorted) {
+    return _CL_bound(list, v, true) - _CL_bound(list, v, false);
   }
-  return n;
+  return _CL_scan(list, v, true);
 }
 
 void CL_fill(CL *list, char v) {
@@ -1057,6 +2808,7 @@ void CL_fill(CL *list, char v) {
     tmpNode->value = v;
     tmpNode = tmpNode->next;
   }
+  list->isSorted = true;
 }
 
 bool CL_join(CL *list, char sep) {
@@ -1076,6 +2828,7 @@ bool CL_join(CL *list, char sep) {
 }
 
 void CL_replace(CL *list, char oldValue, char newValue) {
+  list->isSorted = false;
   CN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
     if(tmpNode->value == oldValue) {
@@ -1094,6 +2847,7 @@ void CL_print(CL *list) {
 }
 
 void CL_forEach(CL *list, void (*cb)(CL *, CN *, int)) {
+  list->isSorted = false;
   CN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
     cb(list, tmpNode, i);
@@ -1101,7 +2855,15 @@ void CL_forEach(CL *list, void (*cb)(CL *, CN *, int)) {
   }
 }
 
+void CL_forEachReverse(CL *list, void (*cb)(CL *, CN *, int)) {
+  list->isSorted = false;
+  for(int i = list->size - 1;i >= 0;i--) {
+    cb(list, CL_getNode(list, i), i);
+  }
+}
+
 CL * CL_map(CL *list, char (*cb)(CL *, CN *, int)) {
+  list->isSorted = false;
   CL *newCL = CL_create();
   if(newCL == NULL) {
     return NULL;
@@ -1118,6 +2880,7 @@ CL * CL_map(CL *list, char (*cb)(CL *, CN *, int)) {
 }
 
 CL * CL_filter(CL *list, bool (*cb)(CL *, CN *, int)) {
+  list->isSorted = false;
   CL *newCL = CL_create();
   if(newCL == NULL) {
     return NULL;
@@ -1138,6 +2901,7 @@ CL * CL_filter(CL *list, bool (*cb)(CL *, CN *, int)) {
 }
 
 bool CL_every(CL *list, bool (*cb)(CL *, CN *, int)) {
+  list->isSorted = false;
   CN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
     if(!cb(list, tmpNode, i)) {
@@ -1147,6 +2911,79 @@ bool CL_every(CL *list, bool (*cb)(CL *, CN *, int)) {
   }
   return true;
 }
+CL_Iter CL_iterBegin(CL *list) {
+  CL_Iter iter = {list, NULL, -1};
+  return iter;
+}
+
+bool CL_iterNext(CL_Iter *iter) {
+  if(iter->index == -1) {
+    iter->node = iter->list->start;
+  }else if(iter->node != NULL) {
+    iter->node = iter->node->next;
+  }else {
+    return false;
+  }
+  iter->index++;
+  return iter->node != NULL;
+}
+
+char CL_iterValue(CL_Iter *iter) {
+  return iter->node == NULL ? '\0' : iter->node->value;
+}
+
+bool CL_iterSet(CL_Iter *iter, char v) {
+  if(iter->node == NULL) {
+    return false;
+  }
+  iter->node->value = v;
+  iter->list->isSorted = false;
+  return true;
+}
+
+bool CL_iterInsertAfter(CL_Iter *iter, char v) {
+  if(iter->node == NULL && iter->index != -1) {
+    return false;
+  }
+  CN *charNode = CN_create(iter->list->pool, v);
+  if(charNode == NULL) {
+    return false;
+  }
+  if(iter->node == NULL) {
+    charNode->next = iter->list->start;
+    iter->list->start = charNode;
+  }else {
+    charNode->next = iter->node->next;
+    iter->node->next = charNode;
+  }
+  if(charNode->next == NULL) {
+    iter->list->end = charNode;
+  }
+  iter->list->isSorted = false;
+  _CL_indexInsert(iter->list, charNode, iter->index + 1);
+  iter->list->size++;
+  return true;
+}
+
+bool CL_iterRemoveNext(CL_Iter *iter) {
+  CN *tmpNode = iter->node == NULL ? iter->list->start : iter->node->next;
+  if(tmpNode == NULL || (iter->node == NULL && iter->index != -1)) {
+    return false;
+  }
+  if(iter->node == NULL) {
+    iter->list->start = tmpNode->next;
+  }else {
+    iter->node->next = tmpNode->next;
+  }
+  if(tmpNode == iter->list->end) {
+    iter->list->end = iter->node;
+  }
+  _CL_indexRemove(iter->list, iter->index + 1);
+  iter->list->size--;
+  CN_delete(iter->list->pool, tmpNode);
+  return true;
+}
+
 
 /*--------------------##############################################################--------------------*/
 /*--------------------#--******--**  **--******----**    --******--******--******--#--------------------*/
@@ -1159,8 +2996,8 @@ bool CL_every(CL *list, bool (*cb)(CL *, CN *, int)) {
 /*--------------------#--******--**  **----**------******--******--******--  **  --#--------------------*/
 /*--------------------##############################################################--------------------*/
 
-static IN * IN_create(int v) {
-  IN *intNode = (IN *)malloc(sizeof(IN));
+static IN * IN_create(STF_Pool *pool, int v) {
+  IN *intNode = (IN *)(pool == NULL ? STF_malloc(sizeof(IN)) : STF_Pool_alloc(pool));
   if(intNode == NULL) {
     return NULL;
   }
@@ -1169,57 +3006,384 @@ static IN * IN_create(int v) {
   return intNode;
 }
 
+static void IN_delete(STF_Pool *pool, IN *intNode) {
+  if(pool == NULL) {
+    STF_release(intNode);
+  }else {
+    STF_Pool_free(pool, intNode);
+  }
+}
+
 static IN * IL_getNode(IL *list, int index) {
   if(index < 0 || index >= list->size) {
     return NULL;
   }
+  if(list->isIndexed || _IL_index(list)) {
+    return list->nodes[list->offset + index];
+  }
+  IN *tmpNode = list->start;
+  for(int i = 0;i < index;i++) {
+    tmpNode = tmpNode->next;
+  }
+  return tmpNode;
+}
+
+static bool _IL_reserve(IL *list, int capacity) {
+  if(list->offset + capacity <= list->capacity) {
+    return true;
+  }
+  // slide the table back to the beginning before growing it
+  if(list->isIndexed && list->offset > 0) {
+    memmove(list->nodes, list->nodes + list->offset, list->size * sizeof(IN *));
+  }
+  list->offset = 0;
+  if(capacity <= list->capacity) {
+    return true;
+  }
+  int newCapacity = list->capacity == 0 ? 16 : list->capacity;
+  while(newCapacity < capacity) {
+    newCapacity *= 2;
+  }
+  IN **nodes = (IN **)STF_reallocWith(STF_Pool_allocator(list->pool), list->nodes, newCapacity * sizeof(IN *));
+  if(nodes == NULL) {
+    return false;
+  }
+  list->nodes = nodes;
+  list->capacity = newCapacity;
+  return true;
+}
+
+static bool _IL_index(IL *list) {
+  // a view shares the nodes of another list and never owns a table
+  if(list->isView) {
+    return false;
+  }
+  list->offset = 0;
+  if(!_IL_reserve(list, list->size)) {
+    return false;
+  }
   IN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(i == index) {
-      return tmpNode;
-    }
+    list->nodes[i] = tmpNode;
     tmpNode = tmpNode->next;
   }
+  list->isIndexed = true;
+  return true;
+}
+
+static void _IL_indexInsert(IL *list, IN *node, int index) {
+  if(!list->isIndexed) {
+    return;
+  }
+  if(index < list->size / 2 && list->offset > 0) {
+    list->offset--;
+    memmove(list->nodes + list->offset, list->nodes + list->offset + 1, index * sizeof(IN *));
+  }else if(index == 0) {
+    // no room in front of the table, it's cheaper to rebuild it when needed
+    list->isIndexed = false;
+    return;
+  }else {
+    if(!_IL_reserve(list, list->size + 1)) {
+      list->isIndexed = false;
+      return;
+    }
+    memmove(list->nodes + list->offset + index + 1, list->nodes + list->offset + index,
+      (list->size - index) * sizeof(IN *));
+  }
+  list->nodes[list->offset + index] = node;
+}
+
+static void _IL_indexRemove(IL *list, int index) {
+  if(!list->isIndexed || index >= list->size) {
+    return;
+  }
+  if(index < list->size / 2) {
+    memmove(list->nodes + list->offset + 1, list->nodes + list->offset, index * sizeof(IN *));
+    list->offset++;
+  }else {
+    memmove(list->nodes + list->offset + index, list->nodes + list->offset + index + 1,
+      (list->size - index - 1) * sizeof(IN *));
+  }
+}
+
+static int _IL_ascending(const void *a, const void *b) {
+  int x = *(const int *)a, y = *(const int *)b;
+  return x < y ? -1 : x > y;
+}
+
+static int _IL_descending(const void *a, const void *b) {
+  return _IL_ascending(b, a);
+}
+
+static void _IL_sortNodes(IL *list, bool isReversed) {
+  if(list->size < 2) {
+    return;
+  }
+  IN *start = list->start, *tail = NULL;
+  for(int width = 1;width < list->size;width *= 2) {
+    IN *left = start;
+    start = tail = NULL;
+    while(left != NULL) {
+      IN *right = left;
+      int leftSize = 0, rightSize = width;
+      while(leftSize < width && right != NULL) {
+        right = right->next;
+        leftSize++;
+      }
+      while(leftSize > 0 || (rightSize > 0 && right != NULL)) {
+        IN *tmpNode;
+        if(leftSize == 0 || (rightSize > 0 && right != NULL &&
+            (isReversed ? left->value < right->value : left->value > right->value))) {
+          tmpNode = right;
+          right = right->next;
+          rightSize--;
+        }else {
+          tmpNode = left;
+          left = left->next;
+          leftSize--;
+        }
+        if(tail == NULL) {
+          start = tmpNode;
+        }else {
+          tail->next = tmpNode;
+        }
+        tail = tmpNode;
+      }
+      left = right;
+    }
+    tail->next = NULL;
+  }
+  list->start = start;
+  list->end = tail;
+  list->isIndexed = false;
+}
+
+static void _IL_radixSort(int *array, int *buffer, int len) {
+  int *source = array, *target = buffer;
+  for(int shift = 0;shift < (int)sizeof(int) * CHAR_BIT;shift += CHAR_BIT) {
+    int counts[UCHAR_MAX + 2] = {0};
+    for(int i = 0;i < len;i++) {
+      counts[((unsigned int)source[i] ^ (unsigned int)INT_MIN) >> shift & UCHAR_MAX]++;
+    }
+    // every value has the same digit, this pass wouldn't move anything
+    if(counts[((unsigned int)source[0] ^ (unsigned int)INT_MIN) >> shift & UCHAR_MAX] == len) {
+      continue;
+    }
+    for(int i = 0, total = 0;i <= UCHAR_MAX;i++) {
+      int count = counts[i];
+      counts[i] = total;
+      total += count;
+    }
+    for(int i = 0;i < len;i++) {
+      target[counts[((unsigned int)source[i] ^ (unsigned int)INT_MIN) >> shift & UCHAR_MAX]++] = source[i];
+    }
+    int *tmp = source;
+    source = target;
+    target = tmp;
+  }
+  if(source != array) {
+    memcpy(array, source, len * sizeof(int));
+  }
 }
 
 static void _IL_sort(IL *list, bool isReversed) {
-  IN *currentNode, *previousNode;
-  bool difference;
-  loopAgain:
-    difference = false;
-    currentNode = previousNode = list->start;
-    for(int i = 0;i < list->size;i++) {
-      currentNode = currentNode->next;
-      if(currentNode != NULL && (isReversed ? previousNode->value < currentNode->value :
-          previousNode->value > currentNode->value)) {
-        int v = currentNode->value;
-        currentNode->value = previousNode->value;
-        previousNode->value = v;
-        difference = true;
+  if(list->size < 2) {
+    return;
+  }
+  int *array = (int *)STF_malloc(list->size * sizeof(int));
+  if(array == NULL) {
+    _IL_sortNodes(list, isReversed);
+    return;
+  }
+  IN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    array[i] = tmpNode->value;
+    tmpNode = tmpNode->next;
+  }
+  int *buffer = list->size < STF_SORT_CUTOFF ? NULL : (int *)STF_malloc(list->size * sizeof(int));
+  if(buffer == NULL) {
+    qsort(array, list->size, sizeof(int), isReversed ? _IL_descending : _IL_ascending);
+    isReversed = false;
+  }else {
+    _IL_radixSort(array, buffer, list->size);
+    STF_release(buffer);
+  }
+  tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    tmpNode->value = array[isReversed ? list->size - 1 - i : i];
+    tmpNode = tmpNode->next;
+  }
+  STF_release(array);
+}
+
+static bool _IL_append(IL *list, int *array, IN *source, int len) {
+  if(len <= 0) {
+    return true;
+  }else if(list->pool != NULL && !STF_Pool_reserve(list->pool, len)) {
+    return false;
+  }
+  IN *first = NULL, *last = NULL;
+  bool isOrdered = true;
+  for(int i = 0;i < len;i++) {
+    IN *intNode = IN_create(list->pool, array != NULL ? array[i] : source->value);
+    if(intNode == NULL) {
+      while(first != NULL) {
+        IN *tmpNode = first->next;
+        IN_delete(list->pool, first);
+        first = tmpNode;
       }
-      previousNode = currentNode;
+      return false;
+    }
+    if(last == NULL ? list->size > 0 && intNode->value < list->end->value : intNode->value < last->value) {
+      isOrdered = false;
+    }
+    if(first == NULL) {
+      first = intNode;
+    }else {
+      last->next = intNode;
     }
-  if(difference) {
-    goto loopAgain;
+    last = intNode;
+    if(array == NULL) {
+      source = source->next;
+    }
+  }
+  if(list->size == 0) {
+    list->start = first;
+  }else {
+    list->end->next = first;
   }
+  list->end = last;
+  if(list->isIndexed && _IL_reserve(list, list->size + len)) {
+    IN **nodes = list->nodes + list->offset + list->size;
+    for(IN *tmpNode = first;tmpNode != NULL;tmpNode = tmpNode->next) {
+      *nodes++ = tmpNode;
+    }
+  }else {
+    list->isIndexed = false;
+  }
+  list->size += len;
+  list->isSorted = list->isSorted && isOrdered;
+  return true;
 }
 
 IL * IL_create() {
-  IL *list = (IL *)malloc(sizeof(IL));
+  IL *list = (IL *)STF_malloc(sizeof(IL));
+  if(list == NULL) {
+    return NULL;
+  }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->pool = NULL;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->isView = false;
+  list->isSorted = true;
+  return list;
+}
+
+IL * IL_createPooled() {
+  IL *list = IL_create();
+  if(list == NULL) {
+    return NULL;
+  }
+  list->pool = STF_Pool_create(sizeof(IN));
+  if(list->pool == NULL) {
+    STF_release(list);
+    return NULL;
+  }
+  return list;
+}
+
+IL * IL_createIn(STF_Arena *arena) {
+  IL *list = (IL *)STF_Arena_alloc(arena, sizeof(IL));
+  if(list == NULL) {
+    return NULL;
+  }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->isView = false;
+  list->isSorted = true;
+  // the list is only tracked once it can be deleted like any arena list
+  list->pool = STF_Pool_createIn(arena, NULL, sizeof(IN));
+  if(list->pool == NULL || !_STF_Arena_track(arena, list, 'I')) {
+    return NULL;
+  }
+  return list;
+}
+
+IL * IL_createWith(const STF_Allocator *allocator) {
+  IL *list = (IL *)STF_allocWith(allocator, sizeof(IL));
   if(list == NULL) {
     return NULL;
   }
   list->start = list->end = NULL;
   list->size = 0;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->isView = false;
+  list->isSorted = true;
+  list->pool = STF_Pool_createIn(NULL, allocator, sizeof(IN));
+  if(list->pool == NULL) {
+    STF_freeWith(allocator, list);
+    return NULL;
+  }
   return list;
 }
 
+bool IL_compact(IL *list) {
+  if(list->isView) {
+    return false;
+  }else if(list->size == 0) {
+    return true;
+  }
+  STF_Pool *pool = STF_Pool_createLike(list->pool, sizeof(IN));
+  if(pool == NULL || !STF_Pool_grow(pool, list->size)) {
+    STF_Pool_delete(pool);
+    return false;
+  }
+  IN *tmpNode = list->start, *lastNode = NULL;
+  for(int i = 0;i < list->size;i++) {
+    IN *newNode = (IN *)STF_Pool_alloc(pool);
+    *newNode = *tmpNode;
+    if(lastNode == NULL) {
+      list->start = newNode;
+    }else {
+      lastNode->next = newNode;
+    }
+    if(list->isIndexed) {
+      list->nodes[list->offset + i] = newNode;
+    }
+    lastNode = newNode;
+    IN *nextNode = tmpNode->next;
+    if(list->pool == NULL) {
+      STF_release(tmpNode);
+    }
+    tmpNode = nextNode;
+  }
+  list->end = lastNode;
+  // every node of a pooled list lives in its chunks, so the old pool can go at once
+  STF_Pool_delete(list->pool);
+  list->pool = pool;
+  return true;
+}
+
 
 bool IL_add(IL *list, int v) {
-  IN *intNode = IN_create(v);
+  IN *intNode = IN_create(list->pool, v);
   if(intNode == NULL) {
     return false;
   }
+  if(list->size > 0 && v < list->end->value) {
+    list->isSorted = false;
+  }
   if(list->size == 0) {
     list->start = list->end = intNode;
   }else if(list->size == 1) {
@@ -1228,15 +3392,19 @@ bool IL_add(IL *list, int v) {
     list->end->next = intNode;
     list->end = list->end->next;
   }
+  _IL_indexInsert(list, intNode, list->size);
   list->size++;
   return true;
 }
 
 bool IL_unshift(IL *list, int v) {
-  IN *intNode = IN_create(v);
+  IN *intNode = IN_create(list->pool, v);
   if(intNode == NULL) {
     return false;
   }
+  if(list->size > 0 && v > list->start->value) {
+    list->isSorted = false;
+  }
   if(list->size == 0) {
     list->start = list->end = intNode;
   }else if(list->size == 1) {
@@ -1247,6 +3415,7 @@ bool IL_unshift(IL *list, int v) {
     list->start = intNode;
     list->start->next = tmpNode;
   }
+  _IL_indexInsert(list, intNode, 0);
   list->size++;
   return true;
 }
@@ -1255,19 +3424,21 @@ int IL_pop(IL *list) {
   int v = 0;
   if(list->size > 2) {
     v = list->end->value;
-    free(list->end);
-    list->end = IL_getNode(list, list->size - 2);
+    IN *previousNode = IL_getNode(list, list->size - 2);
+    IN_delete(list->pool, list->end);
+    list->end = previousNode;
     list->end->next = NULL;
     list->size--;
   }else if(list->size == 2) {
     v = list->end->value;
-    free(list->end);
-    list->start->next = list->end = NULL;
+    IN_delete(list->pool, list->end);
+    list->start->next = NULL;
+    list->end = list->start;
     list->size = 1;
   }else if(list->size == 1) {
     v = list->start->value;
-    free(list->start);
-    list->start = NULL;
+    IN_delete(list->pool, list->start);
+    list->start = list->end = NULL;
     list->size = 0;
   }
   return v;
@@ -1275,16 +3446,17 @@ int IL_pop(IL *list) {
 
 int IL_shift(IL * list) {
   int v = 0;
+  _IL_indexRemove(list, 0);
   if(list->size > 1) {
     IN *tmpNode = list->start->next;
     v = list->start->value;
-    free(list->start);
+    IN_delete(list->pool, list->start);
     list->start = tmpNode;
     list->size--;
   }else if(list->size == 1) {
     v = list->start->value;
-    free(list->start);
-    list->start = NULL;
+    IN_delete(list->pool, list->start);
+    list->start = list->end = NULL;
     list->size = 0;
   }
   return v;
@@ -1300,10 +3472,14 @@ bool IL_insert(IL *list, int v, int index) {
     if(!IL_add(list, v)) return false;
   }else {
     IN *previousNode = IL_getNode(list, index - 1);
-    IN *currentNode = IN_create(v);
+    IN *currentNode = IN_create(list->pool, v);
     if(currentNode == NULL) return false;
+    if(v < previousNode->value || v > previousNode->next->value) {
+      list->isSorted = false;
+    }
     currentNode->next = previousNode->next;
     previousNode->next = currentNode;
+    _IL_indexInsert(list, currentNode, index);
     list->size++;
   }
   return true;
@@ -1321,7 +3497,8 @@ int IL_remove(IL *list, int index) {
       IN *intNode = previousIN->next;
       v = intNode->value;
       previousIN->next = intNode->next;
-      free(intNode);
+      IN_delete(list->pool, intNode);
+      _IL_indexRemove(list, index);
       list->size--;
     }
   }
@@ -1329,45 +3506,57 @@ int IL_remove(IL *list, int index) {
 }
 
 void IL_clear(IL *list) {
-  for(int i = 0, size = list->size;i < size;i++) {
-    IL_shift(list);
+  if(list->isView) {
+    // a view doesn't own its nodes, they stay with the list it was made from
+  }else if(list->pool != NULL) {
+    STF_Pool_reset(list->pool);
+  }else {
+    IN *tmpNode = list->start;
+    for(int i = 0;i < list->size;i++) {
+      IN *nextNode = tmpNode->next;
+      STF_release(tmpNode);
+      tmpNode = nextNode;
+    }
   }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->offset = 0;
+  list->isSorted = true;
 }
 
 void IL_delete(IL *list) {
+  // a list made in an arena keeps its header until the arena is reset
+  bool isInArena = list->pool != NULL && list->pool->arena != NULL;
+  const STF_Allocator *allocator = STF_Pool_allocator(list->pool);
   IL_clear(list);
-  free(list);
+  STF_Pool_delete(list->pool);
+  STF_freeWith(allocator, list->nodes);
+  if(isInArena) {
+    list->nodes = NULL;
+    list->capacity = 0;
+    list->isIndexed = false;
+    return;
+  }
+  STF_freeWith(allocator, list);
 }
 
 bool IL_set(IL * list, int v, int index) {
-  if(index >= 0 && index < list->size) {
-    IN *tmpNode = list->start;
-    for(int i = 0;i < list->size;i++) {
-      if(i == index) {
-        tmpNode->value = v;
-        return true;
-      }
-      tmpNode = tmpNode->next;
-    }
+  IN *tmpNode = IL_getNode(list, index);
+  if(tmpNode == NULL) {
+    return false;
   }
-  return false;
+  tmpNode->value = v;
+  list->isSorted = false;
+  return true;
 }
 
 int IL_get(IL * list, int index) {
-  if(index < 0 || index >= list->size) {
-    return 0;
-  }
-  IN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i == index) {
-      return tmpNode->value;
-    }
-    tmpNode = tmpNode->next;
-  }
+  IN *tmpNode = IL_getNode(list, index);
+  return tmpNode == NULL ? 0 : tmpNode->value;
 }
 
 int * IL_toIntArray(IL *list) {
-  int *array = (int*)malloc(list->size * sizeof(int));
+  int *array = (int*)STF_mallocOut(list->size * sizeof(int));
   if(array == NULL) {
     return NULL;
   }
@@ -1379,86 +3568,173 @@ int * IL_toIntArray(IL *list) {
   return array;
 }
 
-void IL_sort(IL *list) {
-  _IL_sort(list, false);
+void IL_sort(IL *list) {
+  _IL_sort(list, false);
+  list->isSorted = true;
+}
+
+void IL_rsort(IL *list) {
+  _IL_sort(list, true);
+  list->isSorted = false;
+}
+static int _IL_bound(IL *list, int v, bool isUpper) {
+  if(!list->isIndexed && !_IL_index(list)) {
+    IN *tmpNode = list->start;
+    int index = 0;
+    while(index < list->size && (isUpper ? tmpNode->value <= v : tmpNode->value < v)) {
+      tmpNode = tmpNode->next;
+      index++;
+    }
+    return index;
+  }
+  IN **nodes = list->nodes + list->offset;
+  int low = 0, high = list->size;
+  while(low < high) {
+    int middle = low + (high - low) / 2;
+    if(isUpper ? nodes[middle]->value <= v : nodes[middle]->value < v) {
+      low = middle + 1;
+    }else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+int IL_lowerBound(IL *list, int v) {
+  return _IL_bound(list, v, false);
+}
+
+int IL_upperBound(IL *list, int v) {
+  return _IL_bound(list, v, true);
+}
+
+int IL_binarySearch(IL *list, int v) {
+  int index = _IL_bound(list, v, false);
+  return index < list->size && IL_getNode(list, index)->value == v ? index : -1;
 }
 
-void IL_rsort(IL *list) {
-  _IL_sort(list, true);
+bool IL_sortedInsert(IL *list, int v) {
+  return IL_insert(list, v, _IL_bound(list, v, true));
 }
 
 IL * IL_createFrom(int *array, int len) {
-  IL *list = IL_create();
+  IL *list = IL_createPooled();
   if(list == NULL) {
     return NULL;
-  }
-  int i = 0;
-  while(i < len) {
-    if(!IL_add(list, array[i])) {
-      IL_delete(list);
-      return NULL;
-    }
-    i++;
+  }else if(!_IL_append(list, array, NULL, len)) {
+    IL_delete(list);
+    return NULL;
   }
   return list;
 }
 
 IL * IL_copy(IL *list) {
-  IL *listCopy = IL_create();
+  IL *listCopy = IL_createPooled();
   if(listCopy == NULL) {
     return NULL;
-  }
-  IN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(!IL_add(listCopy, tmpNode->value)) {
-      IL_delete(listCopy);
-      return NULL;
-    }
-    tmpNode = tmpNode->next;
+  }else if(!_IL_append(listCopy, NULL, list->start, list->size)) {
+    IL_delete(listCopy);
+    return NULL;
   }
   return listCopy;
 }
 
 bool IL_concatArray(IL *list, int *array, int len) {
-  int i = 0;
-  while(i < len) {
-    if(!IL_add(list, array[i])) {
-      return false;
-    }
-    i++;
-  }
-  return true;
+  return _IL_append(list, array, NULL, len);
 }
 
 bool IL_concatList(IL *listA, IL *listB) {
-  IN *tmpNode = listB->start;
-  for(int i = 0;i < listB->size;i++) {
-    if(!IL_add(listA, tmpNode->value)) {
+  return _IL_append(listA, NULL, listB->start, listB->size);
+}
+static bool _IL_canSplice(IL *list, IL *other) {
+  // a view borrows the nodes of its list and a copied header shares them, moving them would free them twice
+  return list != other && !list->isView && !other->isView && (list->pool == NULL || list->pool != other->pool) &&
+    (other->start == NULL || other->start != list->start);
+}
+
+bool IL_spliceAt(IL *list, int index, IL *other) {
+  if(index < 0 || index > list->size || !_IL_canSplice(list, other)) {
+    return false;
+  }else if(other->size == 0) {
+    return true;
+  }
+  IN *first = other->start, *last = other->end;
+  int size = other->size;
+  if(list->pool != other->pool && list->pool != NULL && other->pool != NULL && list->pool->arena == other->pool->arena &&
+    list->pool->allocator == other->pool->allocator) {
+    STF_Pool_merge(list->pool, other->pool);
+  }else if(list->pool != other->pool) {
+    // the nodes come from different allocators and can't change owner so copy them
+    IL tmpList = {.pool = list->pool};
+    if(!_IL_append(&tmpList, NULL, other->start, other->size)) {
       return false;
     }
-    tmpNode = tmpNode->next;
+    IL_clear(other);
+    first = tmpList.start;
+    last = tmpList.end;
   }
+  if(index == 0) {
+    last->next = list->start;
+    list->start = first;
+  }else {
+    IN *previousNode = IL_getNode(list, index - 1);
+    last->next = previousNode->next;
+    previousNode->next = first;
+  }
+  if(index == list->size) {
+    list->end = last;
+  }
+  list->size += size;
+  list->isIndexed = false;
+  list->isSorted = false;
+  other->start = other->end = NULL;
+  other->size = 0;
+  other->isIndexed = false;
   return true;
 }
 
+bool IL_concatListMove(IL *listA, IL *listB) {
+  return IL_spliceAt(listA, listA->size, listB);
+}
+
+
 bool IL_reverse(IL *list) {
-  IL *tmpIL = IL_create();
-  if(tmpIL == NULL) {
+  return IL_reverseRange(list, 0, list->size);
+}
+
+bool IL_reverseRange(IL *list, int start, int end) {
+  if(start < 0 || end > list->size || start > end) {
     return false;
+  }else if(end - start < 2) {
+    return true;
+  }
+  list->isSorted = false;
+  IN *previousNode = start == 0 ? NULL : IL_getNode(list, start - 1);
+  IN *first = previousNode == NULL ? list->start : previousNode->next;
+  IN *tmpNode = first, *reversed = NULL;
+  for(int i = start;i < end;i++) {
+    IN *nextNode = tmpNode->next;
+    tmpNode->next = reversed;
+    reversed = tmpNode;
+    tmpNode = nextNode;
+  }
+  first->next = tmpNode;
+  if(previousNode == NULL) {
+    list->start = reversed;
+  }else {
+    previousNode->next = reversed;
   }
-  IN *tmpNode = list->start;
-  for(int i = 0;i < list->size; i++) {
-    if(!IL_unshift(tmpIL, tmpNode->value)) {
-      IL_delete(tmpIL);
-      return false;
+  if(end == list->size) {
+    list->end = first;
+  }
+  if(list->isIndexed) {
+    IN **left = list->nodes + list->offset + start, **right = list->nodes + list->offset + end - 1;
+    while(left < right) {
+      IN *swapNode = *left;
+      *left++ = *right;
+      *right-- = swapNode;
     }
-    tmpNode = tmpNode->next;
   }
-  IL_clear(list);
-  list->start = tmpIL->start;
-  list->end = tmpIL->end;
-  list->size = tmpIL->size;
-  free(tmpIL);
   return true;
 }
 
@@ -1466,48 +3742,31 @@ IL * IL_slice(IL *list, int start, int end) {
   if(start >= list->size || start < 0 || end <= start) {
     return NULL;
   }
-  IL *listSub = IL_create();
-  if(listSub == NULL) {
-    return NULL;
+  IL view = IL_view(list, start, end > list->size ? list->size : end);
+  return IL_copy(&view);
+}
+
+IL IL_view(IL *list, int start, int end) {
+  IL view = {.isView = true, .isSorted = list->isSorted};
+  if(start < 0 || end > list->size || start >= end) {
+    return view;
   }
-  IN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i >= start && i < end) {
-      if(!IL_add(listSub, tmpNode->value)) {
-        IL_delete(listSub);
-        return NULL;
-      }
-    }
-    if(i == end - 1) {
-      return listSub;
-    }
-    tmpNode = tmpNode->next;
+  view.start = IL_getNode(list, start);
+  view.end = IL_getNode(list, end - 1);
+  view.size = end - start;
+  if(list->isIndexed) {
+    view.nodes = list->nodes + list->offset + start;
+    view.capacity = view.size;
+    view.isIndexed = true;
   }
-  return listSub;
+  return view;
 }
 
 IL * IL_sub(IL *list, int start, int length) {
   if(start >= list->size || start < 0 || length < 1) {
     return NULL;
   }
-  IL *listSub = IL_create();
-  if(listSub == NULL) {
-    return NULL;
-  }
-  IN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i >= start && i < start + length) {
-      if(!IL_add(listSub, tmpNode->value)) {
-        IL_delete(listSub);
-        return NULL;
-      }
-    }
-    if(i > start + length - 1) {
-      return listSub;
-    }
-    tmpNode = tmpNode->next;
-  }
-  return listSub;
+  return IL_slice(list, start, length > list->size - start ? list->size : start + length);
 }
 
 bool IL_startsWith(IL *list, int v) {
@@ -1520,14 +3779,7 @@ bool IL_endsWith(IL *list, int v) {
 }
 
 bool IL_contains(IL * list, int v) {
-  IN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      return true;
-    }
-    tmpNode = tmpNode->next;
-  }
-  return false;
+  return IL_indexOf(list, v) != -1;
 }
 
 bool IL_isEmpty(IL *list) {
@@ -1574,18 +3826,31 @@ bool IL_isSame(IL *listA, IL *listB) {
   return listA == listB;
 }
 
+static int _IL_scan(IL *list, int v, bool isCounted) {
+  STF_SCAN(IN, list, v, isCounted);
+}
+
 int IL_indexOf(IL * list, int v) {
-  IN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      return i;
-    }
-    tmpNode = tmpNode->next;
+  if(list->isSorted) {
+    int index = _IL_bound(list, v, false);
+    return index < list->size && IL_getNode(list, index)->value == v ? index : -1;
   }
-  return -1;
+  return _IL_scan(list, v, false);
 }
 
 int IL_lastIndexOf(IL * list, int v) {
+  if(list->isSorted) {
+    int index = _IL_bound(list, v, true) - 1;
+    return index >= 0 && IL_getNode(list, index)->value == v ? index : -1;
+  }
+  if(list->isIndexed || _IL_index(list)) {
+    for(int i = list->size - 1;i >= 0;i--) {
+      if(list->nodes[list->offset + i]->value == v) {
+        return i;
+      }
+    }
+    return -1;
+  }
   IN *tmpNode = list->start;
   int index = -1;
   for(int i = 0;i < list->size;i++) {
@@ -1598,15 +3863,10 @@ int IL_lastIndexOf(IL * list, int v) {
 }
 
 int IL_count(IL *list, int v) {
-  IN *tmpNode = list->start;
-  int n = 0;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      n++;
-    }
-    tmpNode = tmpNode->next;
+  if(list->isSorted) {
+    return _IL_bound(list, v, true) - _IL_bound(list, v, false);
   }
-  return n;
+  return _IL_scan(list, v, true);
 }
 
 void IL_fill(IL *list, int v) {
@@ -1615,9 +3875,11 @@ void IL_fill(IL *list, int v) {
     tmpNode->value = v;
     tmpNode = tmpNode->next;
   }
+  list->isSorted = true;
 }
 
 void IL_replace(IL *list, int oldValue, int newValue) {
+  list->isSorted = false;
   IN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
     if(tmpNode->value == oldValue) {
@@ -1639,6 +3901,7 @@ void IL_print(IL *list) {
 }
 
 void IL_forEach(IL *list, void (*cb)(IL *, IN *, int)) {
+  list->isSorted = false;
   IN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
     cb(list, tmpNode, i);
@@ -1646,7 +3909,15 @@ void IL_forEach(IL *list, void (*cb)(IL *, IN *, int)) {
   }
 }
 
+void IL_forEachReverse(IL *list, void (*cb)(IL *, IN *, int)) {
+  list->isSorted = false;
+  for(int i = list->size - 1;i >= 0;i--) {
+    cb(list, IL_getNode(list, i), i);
+  }
+}
+
 IL * IL_map(IL *list, int (*cb)(IL *, IN *, int)) {
+  list->isSorted = false;
   IL *newIL = IL_create();
   if(newIL == NULL) {
     return NULL;
@@ -1662,7 +3933,17 @@ IL * IL_map(IL *list, int (*cb)(IL *, IN *, int)) {
   return newIL;
 }
 
+void IL_mapInPlace(IL *list, int (*fn)(int)) {
+  list->isSorted = false;
+  IN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    tmpNode->value = fn(tmpNode->value);
+    tmpNode = tmpNode->next;
+  }
+}
+
 IL * IL_filter(IL *list, bool (*cb)(IL *, IN *, int)) {
+  list->isSorted = false;
   IL *newIL = IL_create();
   if(newIL == NULL) {
     return NULL;
@@ -1679,91 +3960,514 @@ IL * IL_filter(IL *list, bool (*cb)(IL *, IN *, int)) {
     }
     tmpNode = tmpNode->next;
   }
-  return newIL;
+  return newIL;
+}
+
+bool IL_every(IL *list, bool (*cb)(IL *, IN *, int)) {
+  list->isSorted = false;
+  IN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    if(!cb(list, tmpNode, i)) {
+      return false;
+    }
+    tmpNode = tmpNode->next;
+  }
+  return true;
+}
+static STF_IntSet * _IL_toSet(IL *list) {
+  STF_IntSet *set = STF_IntSet_create(list->size);
+  if(set == NULL) {
+    return NULL;
+  }
+  IN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    STF_IntSet_add(set, tmpNode->value);
+    tmpNode = tmpNode->next;
+  }
+  return set;
+}
+
+static bool _IL_addDistinct(IL *list, IL *source, STF_IntSet *seen, STF_IntSet *filter, bool isKept) {
+  IN *tmpNode = source->start;
+  for(int i = 0;i < source->size;i++) {
+    if((filter == NULL || STF_IntSet_contains(filter, tmpNode->value) == isKept) &&
+       STF_IntSet_add(seen, tmpNode->value) && !IL_add(list, tmpNode->value)) {
+      return false;
+    }
+    tmpNode = tmpNode->next;
+  }
+  return true;
+}
+
+static IL * _IL_combine(IL *listA, IL *listB, bool isUnion, bool isKept) {
+  IL *list = IL_createPooled();
+  STF_IntSet *seen = STF_IntSet_create(listA->size + (listB != NULL && isUnion ? listB->size : 0));
+  STF_IntSet *filter = listB != NULL && !isUnion ? _IL_toSet(listB) : NULL;
+  bool isDone = list != NULL && seen != NULL && (filter != NULL || listB == NULL || isUnion) &&
+    _IL_addDistinct(list, listA, seen, filter, isKept) &&
+    (!isUnion || _IL_addDistinct(list, listB, seen, NULL, true));
+  STF_IntSet_delete(seen);
+  STF_IntSet_delete(filter);
+  if(!isDone && list != NULL) {
+    IL_delete(list);
+    return NULL;
+  }
+  return list;
+}
+
+IL * IL_unique(IL *list) {
+  return _IL_combine(list, NULL, false, true);
+}
+
+IL * IL_intersect(IL *listA, IL *listB) {
+  return _IL_combine(listA, listB, false, true);
+}
+
+IL * IL_union(IL *listA, IL *listB) {
+  return _IL_combine(listA, listB, true, true);
+}
+
+IL * IL_difference(IL *listA, IL *listB) {
+  return _IL_combine(listA, listB, false, false);
+}
+
+IL_Iter IL_iterBegin(IL *list) {
+  IL_Iter iter = {list, NULL, -1};
+  return iter;
+}
+
+bool IL_iterNext(IL_Iter *iter) {
+  if(iter->index == -1) {
+    iter->node = iter->list->start;
+  }else if(iter->node != NULL) {
+    iter->node = iter->node->next;
+  }else {
+    return false;
+  }
+  iter->index++;
+  return iter->node != NULL;
+}
+
+int IL_iterValue(IL_Iter *iter) {
+  return iter->node == NULL ? 0 : iter->node->value;
+}
+
+bool IL_iterSet(IL_Iter *iter, int v) {
+  if(iter->node == NULL) {
+    return false;
+  }
+  iter->node->value = v;
+  iter->list->isSorted = false;
+  return true;
+}
+
+bool IL_iterInsertAfter(IL_Iter *iter, int v) {
+  if(iter->node == NULL && iter->index != -1) {
+    return false;
+  }
+  IN *intNode = IN_create(iter->list->pool, v);
+  if(intNode == NULL) {
+    return false;
+  }
+  if(iter->node == NULL) {
+    intNode->next = iter->list->start;
+    iter->list->start = intNode;
+  }else {
+    intNode->next = iter->node->next;
+    iter->node->next = intNode;
+  }
+  if(intNode->next == NULL) {
+    iter->list->end = intNode;
+  }
+  iter->list->isSorted = false;
+  _IL_indexInsert(iter->list, intNode, iter->index + 1);
+  iter->list->size++;
+  return true;
+}
+
+bool IL_iterRemoveNext(IL_Iter *iter) {
+  IN *tmpNode = iter->node == NULL ? iter->list->start : iter->node->next;
+  if(tmpNode == NULL || (iter->node == NULL && iter->index != -1)) {
+    return false;
+  }
+  if(iter->node == NULL) {
+    iter->list->start = tmpNode->next;
+  }else {
+    iter->node->next = tmpNode->next;
+  }
+  if(tmpNode == iter->list->end) {
+    iter->list->end = iter->node;
+  }
+  _IL_indexRemove(iter->list, iter->index + 1);
+  iter->list->size--;
+  IN_delete(iter->list->pool, tmpNode);
+  return true;
+}
+
+
+/*--------######################################################################################--------*/
+/*--------#--***   -- **** --**  **--***** --**    --******----**    --******--******--******--#--------*/
+/*--------#--***** --******--**  **--******--**    --******----**    --******--******--******--#--------*/
+/*--------#--** ***--**  **--**  **--**  **--**    --**    ----**    --  **  --**    --  **  --#--------*/
+/*--------#--**  **--**  **--**  **--******--**    --***** ----**    --  **  --******--  **  --#--------*/
+/*--------#--**  **--**  **--**  **--******--**    --***** ----**    --  **  --******--  **  --#--------*/
+/*--------#--**  **--**  **--**  **--**  **--**    --**    ----**    --  **  --    **--  **  --#--------*/
+/*--------#--******--******--******--******--******--******----******--******--******--  **  --#--------*/
+/*--------#--***** -- **** --******--***** --******--******----******--******--******--  **  --#--------*/
+/*--------######################################################################################--------*/
+
+static DN * DN_create(STF_Pool *pool, double v) {
+  DN *doubleNode = (DN *)(pool == NULL ? STF_malloc(sizeof(DN)) : STF_Pool_alloc(pool));
+  if(doubleNode == NULL) {
+    return NULL;
+  }
+  doubleNode->value = v;
+  doubleNode->next = NULL;
+  return doubleNode;
+}
+
+static void DN_delete(STF_Pool *pool, DN *doubleNode) {
+  if(pool == NULL) {
+    STF_release(doubleNode);
+  }else {
+    STF_Pool_free(pool, doubleNode);
+  }
+}
+
+static DN * DL_getNode(DL * list, int index) {
+  if(index < 0 || index >= list->size) {
+    return NULL;
+  }
+  if(list->isIndexed || _DL_index(list)) {
+    return list->nodes[list->offset + index];
+  }
+  DN *tmpNode = list->start;
+  for(int i = 0;i < index;i++) {
+    tmpNode = tmpNode->next;
+  }
+  return tmpNode;
+}
+
+static bool _DL_reserve(DL *list, int capacity) {
+  if(list->offset + capacity <= list->capacity) {
+    return true;
+  }
+  // slide the table back to the beginning before growing it
+  if(list->isIndexed && list->offset > 0) {
+    memmove(list->nodes, list->nodes + list->offset, list->size * sizeof(DN *));
+  }
+  list->offset = 0;
+  if(capacity <= list->capacity) {
+    return true;
+  }
+  int newCapacity = list->capacity == 0 ? 16 : list->capacity;
+  while(newCapacity < capacity) {
+    newCapacity *= 2;
+  }
+  DN **nodes = (DN **)STF_reallocWith(STF_Pool_allocator(list->pool), list->nodes, newCapacity * sizeof(DN *));
+  if(nodes == NULL) {
+    return false;
+  }
+  list->nodes = nodes;
+  list->capacity = newCapacity;
+  return true;
+}
+
+static bool _DL_index(DL *list) {
+  // a view shares the nodes of another list and never owns a table
+  if(list->isView) {
+    return false;
+  }
+  list->offset = 0;
+  if(!_DL_reserve(list, list->size)) {
+    return false;
+  }
+  DN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    list->nodes[i] = tmpNode;
+    tmpNode = tmpNode->next;
+  }
+  list->isIndexed = true;
+  return true;
+}
+
+static void _DL_indexInsert(DL *list, DN *node, int index) {
+  if(!list->isIndexed) {
+    return;
+  }
+  if(index < list->size / 2 && list->offset > 0) {
+    list->offset--;
+    memmove(list->nodes + list->offset, list->nodes + list->offset + 1, index * sizeof(DN *));
+  }else if(index == 0) {
+    // no room in front of the table, it's cheaper to rebuild it when needed
+    list->isIndexed = false;
+    return;
+  }else {
+    if(!_DL_reserve(list, list->size + 1)) {
+      list->isIndexed = false;
+      return;
+    }
+    memmove(list->nodes + list->offset + index + 1, list->nodes + list->offset + index,
+      (list->size - index) * sizeof(DN *));
+  }
+  list->nodes[list->offset + index] = node;
+}
+
+static void _DL_indexRemove(DL *list, int index) {
+  if(!list->isIndexed || index >= list->size) {
+    return;
+  }
+  if(index < list->size / 2) {
+    memmove(list->nodes + list->offset + 1, list->nodes + list->offset, index * sizeof(DN *));
+    list->offset++;
+  }else {
+    memmove(list->nodes + list->offset + index, list->nodes + list->offset + index + 1,
+      (list->size - index - 1) * sizeof(DN *));
+  }
+}
+
+static int _DL_ascending(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return x < y ? -1 : x > y;
+}
+
+static int _DL_descending(const void *a, const void *b) {
+  return _DL_ascending(b, a);
+}
+
+static void _DL_sortNodes(DL *list, bool isReversed) {
+  if(list->size < 2) {
+    return;
+  }
+  DN *start = list->start, *tail = NULL;
+  for(int width = 1;width < list->size;width *= 2) {
+    DN *left = start;
+    start = tail = NULL;
+    while(left != NULL) {
+      DN *right = left;
+      int leftSize = 0, rightSize = width;
+      while(leftSize < width && right != NULL) {
+        right = right->next;
+        leftSize++;
+      }
+      while(leftSize > 0 || (rightSize > 0 && right != NULL)) {
+        DN *tmpNode;
+        if(leftSize == 0 || (rightSize > 0 && right != NULL &&
+            (isReversed ? left->value < right->value : left->value > right->value))) {
+          tmpNode = right;
+          right = right->next;
+          rightSize--;
+        }else {
+          tmpNode = left;
+          left = left->next;
+          leftSize--;
+        }
+        if(tail == NULL) {
+          start = tmpNode;
+        }else {
+          tail->next = tmpNode;
+        }
+        tail = tmpNode;
+      }
+      left = right;
+    }
+    tail->next = NULL;
+  }
+  list->start = start;
+  list->end = tail;
+  list->isIndexed = false;
+}
+
+static void _DL_sort(DL *list, bool isReversed) {
+  if(list->size < 2) {
+    return;
+  }
+  double *array = (double *)STF_malloc(list->size * sizeof(double));
+  if(array == NULL) {
+    _DL_sortNodes(list, isReversed);
+    return;
+  }
+  DN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    array[i] = tmpNode->value;
+    tmpNode = tmpNode->next;
+  }
+  qsort(array, list->size, sizeof(double), isReversed ? _DL_descending : _DL_ascending);
+  tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    tmpNode->value = array[i];
+    tmpNode = tmpNode->next;
+  }
+  STF_release(array);
 }
 
-bool IL_every(IL *list, bool (*cb)(IL *, IN *, int)) {
-  IN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(!cb(list, tmpNode, i)) {
+static bool _DL_append(DL *list, double *array, DN *source, int len) {
+  if(len <= 0) {
+    return true;
+  }else if(list->pool != NULL && !STF_Pool_reserve(list->pool, len)) {
+    return false;
+  }
+  DN *first = NULL, *last = NULL;
+  bool isOrdered = true;
+  for(int i = 0;i < len;i++) {
+    DN *doubleNode = DN_create(list->pool, array != NULL ? array[i] : source->value);
+    if(doubleNode == NULL) {
+      while(first != NULL) {
+        DN *tmpNode = first->next;
+        DN_delete(list->pool, first);
+        first = tmpNode;
+      }
       return false;
     }
-    tmpNode = tmpNode->next;
+    if(last == NULL ? list->size > 0 && doubleNode->value < list->end->value : doubleNode->value < last->value) {
+      isOrdered = false;
+    }
+    if(first == NULL) {
+      first = doubleNode;
+    }else {
+      last->next = doubleNode;
+    }
+    last = doubleNode;
+    if(array == NULL) {
+      source = source->next;
+    }
+  }
+  if(list->size == 0) {
+    list->start = first;
+  }else {
+    list->end->next = first;
   }
+  list->end = last;
+  if(list->isIndexed && _DL_reserve(list, list->size + len)) {
+    DN **nodes = list->nodes + list->offset + list->size;
+    for(DN *tmpNode = first;tmpNode != NULL;tmpNode = tmpNode->next) {
+      *nodes++ = tmpNode;
+    }
+  }else {
+    list->isIndexed = false;
+  }
+  list->size += len;
+  list->isSorted = list->isSorted && isOrdered;
   return true;
 }
 
-/*--------######################################################################################--------*/
-/*--------#--***   -- **** --**  **--***** --**    --******----**    --******--******--******--#--------*/
-/*--------#--***** --******--**  **--******--**    --******----**    --******--******--******--#--------*/
-/*--------#--** ***--**  **--**  **--**  **--**    --**    ----**    --  **  --**    --  **  --#--------*/
-/*--------#--**  **--**  **--**  **--******--**    --***** ----**    --  **  --******--  **  --#--------*/
-/*--------#--**  **--**  **--**  **--******--**    --***** ----**    --  **  --******--  **  --#--------*/
-/*--------#--**  **--**  **--**  **--**  **--**    --**    ----**    --  **  --    **--  **  --#--------*/
-/*--------#--******--******--******--******--******--******----******--******--******--  **  --#--------*/
-/*--------#--***** -- **** --******--***** --******--******----******--******--******--  **  --#--------*/
-/*--------######################################################################################--------*/
-
-static DN * DN_create(double v) {
-  DN *doubleNode = (DN *)malloc(sizeof(DN));
-  if(doubleNode == NULL) {
+DL * DL_create() {
+  DL *list = (DL *)STF_malloc(sizeof(DL));
+  if(list == NULL) {
     return NULL;
   }
-  doubleNode->value = v;
-  doubleNode->next = NULL;
-  return doubleNode;
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->pool = NULL;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->isView = false;
+  list->isSorted = true;
+  return list;
 }
 
-static DN * DL_getNode(DL * list, int index) {
-  if(index < 0 || index >= list->size) {
+DL * DL_createPooled() {
+  DL *list = DL_create();
+  if(list == NULL) {
     return NULL;
   }
-  DN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i == index) {
-      return tmpNode;
-    }
-    tmpNode = tmpNode->next;
+  list->pool = STF_Pool_create(sizeof(DN));
+  if(list->pool == NULL) {
+    STF_release(list);
+    return NULL;
   }
+  return list;
 }
 
-static void _DL_sort(DL *list, bool isReversed) {
-  DN *currentNode, *previousNode;
-  bool difference;
-  loopAgain:
-    difference = false;
-    currentNode = previousNode = list->start;
-    for(int i = 0;i < list->size;i++) {
-      currentNode = currentNode->next;
-      if(currentNode != NULL && (isReversed ? previousNode->value < currentNode->value :
-          previousNode->value > currentNode->value)) {
-        double v = currentNode->value;
-        currentNode->value = previousNode->value;
-        previousNode->value = v;
-        difference = true;
-      }
-      previousNode = currentNode;
-    }
-  if(difference) {
-    goto loopAgain;
+DL * DL_createIn(STF_Arena *arena) {
+  DL *list = (DL *)STF_Arena_alloc(arena, sizeof(DL));
+  if(list == NULL) {
+    return NULL;
+  }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->isView = false;
+  list->isSorted = true;
+  // the list is only tracked once it can be deleted like any arena list
+  list->pool = STF_Pool_createIn(arena, NULL, sizeof(DN));
+  if(list->pool == NULL || !_STF_Arena_track(arena, list, 'D')) {
+    return NULL;
   }
+  return list;
 }
 
-DL * DL_create() {
-  DL *list = (DL *)malloc(sizeof(DL));
+DL * DL_createWith(const STF_Allocator *allocator) {
+  DL *list = (DL *)STF_allocWith(allocator, sizeof(DL));
   if(list == NULL) {
     return NULL;
   }
   list->start = list->end = NULL;
   list->size = 0;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->isView = false;
+  list->isSorted = true;
+  list->pool = STF_Pool_createIn(NULL, allocator, sizeof(DN));
+  if(list->pool == NULL) {
+    STF_freeWith(allocator, list);
+    return NULL;
+  }
   return list;
 }
 
+bool DL_compact(DL *list) {
+  if(list->isView) {
+    return false;
+  }else if(list->size == 0) {
+    return true;
+  }
+  STF_Pool *pool = STF_Pool_createLike(list->pool, sizeof(DN));
+  if(pool == NULL || !STF_Pool_grow(pool, list->size)) {
+    STF_Pool_delete(pool);
+    return false;
+  }
+  DN *tmpNode = list->start, *lastNode = NULL;
+  for(int i = 0;i < list->size;i++) {
+    DN *newNode = (DN *)STF_Pool_alloc(pool);
+    *newNode = *tmpNode;
+    if(lastNode == NULL) {
+      list->start = newNode;
+    }else {
+      lastNode->next = newNode;
+    }
+    if(list->isIndexed) {
+      list->nodes[list->offset + i] = newNode;
+    }
+    lastNode = newNode;
+    DN *nextNode = tmpNode->next;
+    if(list->pool == NULL) {
+      STF_release(tmpNode);
+    }
+    tmpNode = nextNode;
+  }
+  list->end = lastNode;
+  // every node of a pooled list lives in its chunks, so the old pool can go at once
+  STF_Pool_delete(list->pool);
+  list->pool = pool;
+  return true;
+}
+
 bool DL_add(DL *list, double v) {
-  DN *doubleNode = DN_create(v);
+  DN *doubleNode = DN_create(list->pool, v);
   if(doubleNode == NULL) {
     return false;
   }
+  if(list->size > 0 && v < list->end->value) {
+    list->isSorted = false;
+  }
   if(list->size == 0) {
     list->start = list->end = doubleNode;
   }else if(list->size == 1) {
@@ -1772,15 +4476,19 @@ bool DL_add(DL *list, double v) {
     list->end->next = doubleNode;
     list->end = list->end->next;
   }
+  _DL_indexInsert(list, doubleNode, list->size);
   list->size++;
   return true;
 }
 
 bool DL_unshift(DL * list, double v) {
-  DN *doubleNode = DN_create(v);
+  DN *doubleNode = DN_create(list->pool, v);
   if(doubleNode == NULL) {
     return false;
   }
+  if(list->size > 0 && v > list->start->value) {
+    list->isSorted = false;
+  }
   if(list->size == 0) {
     list->start = list->end = doubleNode;
   }else if(list->size == 1) {
@@ -1791,6 +4499,7 @@ bool DL_unshift(DL * list, double v) {
     list->start = doubleNode;
     list->start->next = tmpNode;
   }
+  _DL_indexInsert(list, doubleNode, 0);
   list->size++;
   return true;
 }
@@ -1799,19 +4508,21 @@ double DL_pop(DL *list) {
   double v = 0;
   if(list->size > 2) {
     v = list->end->value;
-    free(list->end);
-    list->end = DL_getNode(list, list->size - 2);
+    DN *previousNode = DL_getNode(list, list->size - 2);
+    DN_delete(list->pool, list->end);
+    list->end = previousNode;
     list->end->next = NULL;
     list->size--;
   }else if(list->size == 2) {
     v = list->end->value;
-    free(list->end);
-    list->start->next = list->end = NULL;
+    DN_delete(list->pool, list->end);
+    list->start->next = NULL;
+    list->end = list->start;
     list->size = 1;
   }else if(list->size == 1) {
     v = list->start->value;
-    free(list->start);
-    list->start = NULL;
+    DN_delete(list->pool, list->start);
+    list->start = list->end = NULL;
     list->size = 0;
   }
   return v;
@@ -1819,16 +4530,17 @@ double DL_pop(DL *list) {
 
 double DL_shift(DL * list) {
   double v = 0;
+  _DL_indexRemove(list, 0);
   if(list->size > 1) {
     DN *tmpNode = list->start->next;
     v = list->start->value;
-    free(list->start);
+    DN_delete(list->pool, list->start);
     list->start = tmpNode;
     list->size--;
   }else if(list->size == 1) {
     v = list->start->value;
-    free(list->start);
-    list->start = NULL;
+    DN_delete(list->pool, list->start);
+    list->start = list->end = NULL;
     list->size = 0;
   }
   return v;
@@ -1844,10 +4556,14 @@ bool DL_insert(DL *list, double v, int index) {
     if(!DL_add(list, v)) return false;
   }else {
     DN *previousNode = DL_getNode(list, index - 1);
-    DN *currentNode = DN_create(v);
+    DN *currentNode = DN_create(list->pool, v);
     if(currentNode == NULL) return false;
+    if(v < previousNode->value || v > previousNode->next->value) {
+      list->isSorted = false;
+    }
     currentNode->next = previousNode->next;
     previousNode->next = currentNode;
+    _DL_indexInsert(list, currentNode, index);
     list->size++;
   }
   return true;
@@ -1865,449 +4581,1172 @@ double DL_remove(DL *list, int index) {
       DN *doubleNode = previousDN->next;
       v = doubleNode->value;
       previousDN->next = doubleNode->next;
-      free(doubleNode);
+      DN_delete(list->pool, doubleNode);
+      _DL_indexRemove(list, index);
       list->size--;
     }
   }
-  return v;
+  return v;
+}
+
+void DL_clear(DL *list) {
+  if(list->isView) {
+    // a view doesn't own its nodes, they stay with the list it was made from
+  }else if(list->pool != NULL) {
+    STF_Pool_reset(list->pool);
+  }else {
+    DN *tmpNode = list->start;
+    for(int i = 0;i < list->size;i++) {
+      DN *nextNode = tmpNode->next;
+      STF_release(tmpNode);
+      tmpNode = nextNode;
+    }
+  }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->offset = 0;
+  list->isSorted = true;
+}
+
+void DL_delete(DL *list) {
+  // a list made in an arena keeps its header until the arena is reset
+  bool isInArena = list->pool != NULL && list->pool->arena != NULL;
+  const STF_Allocator *allocator = STF_Pool_allocator(list->pool);
+  DL_clear(list);
+  STF_Pool_delete(list->pool);
+  STF_freeWith(allocator, list->nodes);
+  if(isInArena) {
+    list->nodes = NULL;
+    list->capacity = 0;
+    list->isIndexed = false;
+    return;
+  }
+  STF_freeWith(allocator, list);
+}
+
+bool DL_set(DL * list, double v, int index) {
+  DN *tmpNode = DL_getNode(list, index);
+  if(tmpNode == NULL) {
+    return false;
+  }
+  tmpNode->value = v;
+  list->isSorted = false;
+  return true;
+}
+
+double DL_get(DL * list, int index) {
+  DN *tmpNode = DL_getNode(list, index);
+  return tmpNode == NULL ? 0 : tmpNode->value;
+}
+
+double * DL_toDoubleArray(DL *list) {
+  double *array = (double*)STF_mallocOut(list->size * sizeof(double));
+  if(array == NULL) {
+    return NULL;
+  }
+  DN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    array[i] = tmpNode->value;
+    tmpNode = tmpNode->next;
+  }
+  return array;
+}
+
+void DL_sort(DL *list) {
+  _DL_sort(list, false);
+  list->isSorted = true;
+}
+
+void DL_rsort(DL *list) {
+  _DL_sort(list, true);
+  list->isSorted = false;
+}
+static int _DL_bound(DL *list, double v, bool isUpper) {
+  if(!list->isIndexed && !_DL_index(list)) {
+    DN *tmpNode = list->start;
+    int index = 0;
+    while(index < list->size && (isUpper ? tmpNode->value <= v : tmpNode->value < v)) {
+      tmpNode = tmpNode->next;
+      index++;
+    }
+    return index;
+  }
+  DN **nodes = list->nodes + list->offset;
+  int low = 0, high = list->size;
+  while(low < high) {
+    int middle = low + (high - low) / 2;
+    if(isUpper ? nodes[middle]->value <= v : nodes[middle]->value < v) {
+      low = middle + 1;
+    }else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+int DL_lowerBound(DL *list, double v) {
+  return _DL_bound(list, v, false);
+}
+
+int DL_upperBound(DL *list, double v) {
+  return _DL_bound(list, v, true);
+}
+
+int DL_binarySearch(DL *list, double v) {
+  int index = _DL_bound(list, v, false);
+  return index < list->size && DL_getNode(list, index)->value == v ? index : -1;
+}
+
+bool DL_sortedInsert(DL *list, double v) {
+  return DL_insert(list, v, _DL_bound(list, v, true));
+}
+
+DL * DL_createFrom(double *array, int len) {
+  DL *list = DL_createPooled();
+  if(list == NULL) {
+    return NULL;
+  }else if(!_DL_append(list, array, NULL, len)) {
+    DL_delete(list);
+    return NULL;
+  }
+  return list;
+}
+
+DL * DL_copy(DL *list) {
+  DL *listCopy = DL_createPooled();
+  if(listCopy == NULL) {
+    return NULL;
+  }else if(!_DL_append(listCopy, NULL, list->start, list->size)) {
+    DL_delete(listCopy);
+    return NULL;
+  }
+  return listCopy;
+}
+
+bool DL_concatArray(DL *list, double *array, int len) {
+  return _DL_append(list, array, NULL, len);
+}
+
+bool DL_concatList(DL *listA, DL *listB) {
+  return _DL_append(listA, NULL, listB->start, listB->size);
+}
+static bool _DL_canSplice(DL *list, DL *other) {
+  // a view borrows the nodes of its list and a copied header shares them, moving them would free them twice
+  return list != other && !list->isView && !other->isView && (list->pool == NULL || list->pool != other->pool) &&
+    (other->start == NULL || other->start != list->start);
+}
+
+bool DL_spliceAt(DL *list, int index, DL *other) {
+  if(index < 0 || index > list->size || !_DL_canSplice(list, other)) {
+    return false;
+  }else if(other->size == 0) {
+    return true;
+  }
+  DN *first = other->start, *last = other->end;
+  int size = other->size;
+  if(list->pool != other->pool && list->pool != NULL && other->pool != NULL && list->pool->arena == other->pool->arena &&
+    list->pool->allocator == other->pool->allocator) {
+    STF_Pool_merge(list->pool, other->pool);
+  }else if(list->pool != other->pool) {
+    // the nodes come from different allocators and can't change owner so copy them
+    DL tmpList = {.pool = list->pool};
+    if(!_DL_append(&tmpList, NULL, other->start, other->size)) {
+      return false;
+    }
+    DL_clear(other);
+    first = tmpList.start;
+    last = tmpList.end;
+  }
+  if(index == 0) {
+    last->next = list->start;
+    list->start = first;
+  }else {
+    DN *previousNode = DL_getNode(list, index - 1);
+    last->next = previousNode->next;
+    previousNode->next = first;
+  }
+  if(index == list->size) {
+    list->end = last;
+  }
+  list->size += size;
+  list->isIndexed = false;
+  list->isSorted = false;
+  other->start = other->end = NULL;
+  other->size = 0;
+  other->isIndexed = false;
+  return true;
+}
+
+bool DL_concatListMove(DL *listA, DL *listB) {
+  return DL_spliceAt(listA, listA->size, listB);
+}
+
+
+bool DL_reverse(DL *list) {
+  return DL_reverseRange(list, 0, list->size);
+}
+
+bool DL_reverseRange(DL *list, int start, int end) {
+  if(start < 0 || end > list->size || start > end) {
+    return false;
+  }else if(end - start < 2) {
+    return true;
+  }
+  list->isSorted = false;
+  DN *previousNode = start == 0 ? NULL : DL_getNode(list, start - 1);
+  DN *first = previousNode == NULL ? list->start : previousNode->next;
+  DN *tmpNode = first, *reversed = NULL;
+  for(int i = start;i < end;i++) {
+    DN *nextNode = tmpNode->next;
+    tmpNode->next = reversed;
+    reversed = tmpNode;
+    tmpNode = nextNode;
+  }
+  first->next = tmpNode;
+  if(previousNode == NULL) {
+    list->start = reversed;
+  }else {
+    previousNode->next = reversed;
+  }
+  if(end == list->size) {
+    list->end = first;
+  }
+  if(list->isIndexed) {
+    DN **left = list->nodes + list->offset + start, **right = list->nodes + list->offset + end - 1;
+    while(left < right) {
+      DN *swapNode = *left;
+      *left++ = *right;
+      *right-- = swapNode;
+    }
+  }
+  return true;
+}
+
+DL * DL_slice(DL *list, int start, int end) {
+  if(start >= list->size || start < 0 || end <= start) {
+    return NULL;
+  }
+  DL view = DL_view(list, start, end > list->size ? list->size : end);
+  return DL_copy(&view);
+}
+
+DL DL_view(DL *list, int start, int end) {
+  DL view = {.isView = true, .isSorted = list->isSorted};
+  if(start < 0 || end > list->size || start >= end) {
+    return view;
+  }
+  view.start = DL_getNode(list, start);
+  view.end = DL_getNode(list, end - 1);
+  view.size = end - start;
+  if(list->isIndexed) {
+    view.nodes = list->nodes + list->offset + start;
+    view.capacity = view.size;
+    view.isIndexed = true;
+  }
+  return view;
+}
+
+DL * DL_sub(DL *list, int start, int length) {
+  if(start >= list->size || start < 0 || length < 1) {
+    return NULL;
+  }
+  return DL_slice(list, start, length > list->size - start ? list->size : start + length);
+}
+
+bool DL_startsWith(DL *list, double v) {
+  return list->size > 0 && list->start->value == v;
+}
+
+bool DL_endsWith(DL *list, double v) {
+  return list->size == 1 && list->start->value == v || 
+    list->size > 0 && list->end->value == v;
+}
+
+bool DL_contains(DL * list, double v) {
+  return DL_indexOf(list, v) != -1;
+}
+
+bool DL_isEmpty(DL *list) {
+  return list->size == 0 ? 1 : 0;
+}
+
+int DL_compare(DL *listA, DL *listB) {
+  int len = listA->size > listB->size ? listB->size : listA->size;
+  DN *tmpNodeA = listA->start;
+  DN *tmpNodeB = listB->start;
+  for(int i = 0;i < len;i++) {
+    if(tmpNodeA->value < tmpNodeB->value) {
+      return 1;
+    }else if(tmpNodeA->value > tmpNodeB->value) {
+      return -1;
+    }
+    tmpNodeA = tmpNodeA->next;
+    tmpNodeB = tmpNodeB->next;
+  }
+  if(listA->size > listB->size) return -1;
+  else if(listA->size < listB->size) return 1;
+  return 0;
+}
+
+bool DL_equalsList(DL *listA, DL *listB) {
+  return DL_compare(listA, listB) == 0;
+}
+
+bool DL_equalsArray(DL *list, double *array, int len) {
+  if(list->size != len) {
+    return false;
+  }
+  DN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    if(tmpNode->value != array[i]) {
+      return false;
+    }
+    tmpNode = tmpNode->next;
+  }
+  return true;
 }
 
-void DL_clear(DL *list) {
-  for(int i = 0, size = list->size;i < size;i++) {
-    DL_shift(list);
-  }
+bool DL_isSame(DL *listA, DL *listB) {
+  return listA == listB;
 }
 
-void DL_delete(DL *list) {
-  DL_clear(list);
-  free(list);
+static int _DL_scan(DL *list, double v, bool isCounted) {
+  STF_SCAN(DN, list, v, isCounted);
 }
 
-bool DL_set(DL * list, double v, int index) {
-  if(index >= 0 && index < list->size) {
-    DN *tmpNode = list->start;
-    for(int i = 0;i < list->size;i++) {
-      if(i == index) {
-        tmpNode->value = v;
-        return true;
+int DL_indexOf(DL * list, double v) {
+  if(list->isSorted) {
+    int index = _DL_bound(list, v, false);
+    return index < list->size && DL_getNode(list, index)->value == v ? index : -1;
+  }
+  return _DL_scan(list, v, false);
+}
+
+int DL_lastIndexOf(DL * list, double v) {
+  if(list->isSorted) {
+    int index = _DL_bound(list, v, true) - 1;
+    return index >= 0 && DL_getNode(list, index)->value == v ? index : -1;
+  }
+  if(list->isIndexed || _DL_index(list)) {
+    for(int i = list->size - 1;i >= 0;i--) {
+      if(list->nodes[list->offset + i]->value == v) {
+        return i;
       }
-      tmpNode = tmpNode->next;
     }
+    return -1;
   }
-  return false;
+  DN *tmpNode = list->start;
+  int index = -1;
+  for(int i = 0;i < list->size;i++) {
+    if(tmpNode->value == v) {
+      index = i;
+    }
+    tmpNode = tmpNode->next;
+  }
+  return index;
 }
 
-double DL_get(DL * list, int index) {
-  if(index < 0 || index >= list->size) {
-    return 0;
+int DL_count(DL *list, double v) {
+  if(list->isSorted) {
+    return _DL_bound(list, v, true) - _DL_bound(list, v, false);
   }
+  return _DL_scan(list, v, true);
+}
+
+void DL_fill(DL *list, double v) {
   DN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(i == index) {
-      return tmpNode->value;
-    }
+    tmpNode->value = v;
     tmpNode = tmpNode->next;
   }
+  list->isSorted = true;
 }
 
-double * DL_toDoubleArray(DL *list) {
-  double *array = (double*)malloc(list->size * sizeof(double));
-  if(array == NULL) {
-    return NULL;
+void DL_replace(DL *list, double oldValue, double newValue) {
+  list->isSorted = false;
+  DN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    if(tmpNode->value == oldValue) {
+      tmpNode->value = newValue;
+    }
+    tmpNode = tmpNode->next;
   }
+}
+
+void DL_print(DL *list) {
   DN *tmpNode = list->start;
+  printf("{");
   for(int i = 0;i < list->size;i++) {
-    array[i] = tmpNode->value;
+    printf("%.2lf", tmpNode->value);
     tmpNode = tmpNode->next;
+    i != list->size - 1 && printf(", ");
   }
-  return array;
+  printf("}");
 }
 
-void DL_sort(DL *list) {
-  _DL_sort(list, false);
+void DL_forEach(DL *list, void (*cb)(DL *, DN *, int)) {
+  list->isSorted = false;
+  DN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    cb(list, tmpNode, i);
+    tmpNode = tmpNode->next;
+  }
 }
 
-void DL_rsort(DL *list) {
-  _DL_sort(list, true);
+void DL_forEachReverse(DL *list, void (*cb)(DL *, DN *, int)) {
+  list->isSorted = false;
+  for(int i = list->size - 1;i >= 0;i--) {
+    cb(list, DL_getNode(list, i), i);
+  }
 }
 
-DL * DL_createFrom(double *array, int len) {
-  DL *list = DL_create();
-  if(list == NULL) {
+DL * DL_map(DL *list, double (*cb)(DL *, DN *, int)) {
+  list->isSorted = false;
+  DL *newDL = DL_create();
+  if(newDL == NULL) {
     return NULL;
-  }
-  int i = 0;
-  while(i < len) {
-    if(!DL_add(list, array[i])) {
-      DL_delete(list);
+  }  
+  DN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    if(!DL_add(newDL, cb(list, tmpNode, i))) {
+      DL_delete(newDL);
       return NULL;
     }
-    i++;
+    tmpNode = tmpNode->next;
   }
-  return list;
+  return newDL;
 }
 
-DL * DL_copy(DL *list) {
-  DL *listCopy = DL_create();
-  if(listCopy == NULL) {
+DL * DL_filter(DL *list, bool (*cb)(DL *, DN *, int)) {
+  list->isSorted = false;
+  DL *newDL = DL_create();
+  if(newDL == NULL) {
     return NULL;
   }
   DN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(!DL_add(listCopy, tmpNode->value)) {
-      DL_delete(listCopy);
+    if(!cb(list, tmpNode, i)) {
+      tmpNode = tmpNode->next;
+      continue;
+    }
+    if(!DL_add(newDL, tmpNode->value)) {
+      DL_delete(newDL);
       return NULL;
     }
     tmpNode = tmpNode->next;
   }
-  return listCopy;
+  return newDL;
 }
 
-bool DL_concatArray(DL *list, double *array, int len) {
-  int i = 0;
-  while(i < len) {
-    if(!DL_add(list, array[i])) {
+bool DL_every(DL *list, bool (*cb)(DL *, DN *, int)) {
+  list->isSorted = false;
+  DN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    if(!cb(list, tmpNode, i)) {
       return false;
     }
-    i++;
+    tmpNode = tmpNode->next;
   }
   return true;
 }
+DL_Iter DL_iterBegin(DL *list) {
+  DL_Iter iter = {list, NULL, -1};
+  return iter;
+}
 
-bool DL_concatList(DL *listA, DL *listB) {
-  DN *tmpNode = listB->start;
-  for(int i = 0;i < listB->size;i++) {
-    if(!DL_add(listA, tmpNode->value)) {
-      return false;
+bool DL_iterNext(DL_Iter *iter) {
+  if(iter->index == -1) {
+    iter->node = iter->list->start;
+  }else if(iter->node != NULL) {
+    iter->node = iter->node->next;
+  }else {
+    return false;
+  }
+  iter->index++;
+  return iter->node != NULL;
+}
+
+double DL_iterValue(DL_Iter *iter) {
+  return iter->node == NULL ? 0 : iter->node->value;
+}
+
+bool DL_iterSet(DL_Iter *iter, double v) {
+  if(iter->node == NULL) {
+    return false;
+  }
+  iter->node->value = v;
+  iter->list->isSorted = false;
+  return true;
+}
+
+bool DL_iterInsertAfter(DL_Iter *iter, double v) {
+  if(iter->node == NULL && iter->index != -1) {
+    return false;
+  }
+  DN *doubleNode = DN_create(iter->list->pool, v);
+  if(doubleNode == NULL) {
+    return false;
+  }
+  if(iter->node == NULL) {
+    doubleNode->next = iter->list->start;
+    iter->list->start = doubleNode;
+  }else {
+    doubleNode->next = iter->node->next;
+    iter->node->next = doubleNode;
+  }
+  if(doubleNode->next == NULL) {
+    iter->list->end = doubleNode;
+  }
+  iter->list->isSorted = false;
+  _DL_indexInsert(iter->list, doubleNode, iter->index + 1);
+  iter->list->size++;
+  return true;
+}
+
+bool DL_iterRemoveNext(DL_Iter *iter) {
+  DN *tmpNode = iter->node == NULL ? iter->list->start : iter->node->next;
+  if(tmpNode == NULL || (iter->node == NULL && iter->index != -1)) {
+    return false;
+  }
+  if(iter->node == NULL) {
+    iter->list->start = tmpNode->next;
+  }else {
+    iter->node->next = tmpNode->next;
+  }
+  if(tmpNode == iter->list->end) {
+    iter->list->end = iter->node;
+  }
+  _DL_indexRemove(iter->list, iter->index + 1);
+  iter->list->size--;
+  DN_delete(iter->list->pool, tmpNode);
+  return true;
+}
+
+
+/*--------######################################################################################--------*/
+/*--------#--******--******--******--******--**  **--******----**    --******--******--******--#--------*/
+/*--------#--******--******--******--******--**  **--******----**    --******--******--******--#--------*/
+/*--------#--**    --  **  --**  **--  **  --*** **--**    ----**    --  **  --**    --  **  --#--------*/
+/*--------#--******--  **  --******--  **  --******--**    ----**    --  **  --******--  **  --#--------*/
+/*--------#--******--  **  --****  --  **  --******--** ***----**    --  **  --******--  **  --#--------*/
+/*--------#--    **--  **  --******--  **  --** ***--**  **----**    --  **  --    **--  **  --#--------*/
+/*--------#--******--  **  --**  **--******--**  **--******----******--******--******--  **  --#--------*/
+/*--------#--******----**----**  **--******--**  **--******----******--******--******--  **  --#--------*/
+/*--------######################################################################################--------*/
+
+static String _SN_buffer(SN *stringNode) {
+  return stringNode->isShort ? stringNode->storage.shortChars : stringNode->storage.chars;
+}
+
+static STF_Intern * _SN_intern(SN *stringNode) {
+  return stringNode->isInterned ? STF_Hash_ownerOf(stringNode->storage.chars) : NULL;
+}
+
+static void _SN_freeChars(SN *stringNode) {
+  if(stringNode->isInterned) {
+    if(stringNode->storage.chars != NULL) {
+      STF_unintern(stringNode->storage.chars, stringNode->length);
     }
-    tmpNode = tmpNode->next;
+  }else if(!stringNode->isShort) {
+    STF_release(stringNode->storage.chars);
+  }
+  stringNode->storage.chars = NULL;
+  stringNode->isShort = false;
+}
+
+static bool SN_setInterned(SN *stringNode, STF_Intern *intern) {
+  if(SN_chars(stringNode) == NULL) {
+    return false;
+  }else if(_SN_intern(stringNode) == intern) {
+    return true;
+  }
+  // the copy keeps the old chars, even short ones, while the node gets new ones
+  SN oldNode = *stringNode;
+  stringNode->storage.chars = NULL;
+  stringNode->isShort = false;
+  stringNode->isInterned = false;
+  if(!SN_setChars(stringNode, _SN_buffer(&oldNode), oldNode.length, intern)) {
+    *stringNode = oldNode;
+    return false;
   }
+  _SN_freeChars(&oldNode);
   return true;
 }
 
-bool DL_reverse(DL *list) {
-  DL *tmpDL = DL_create();
-  if(tmpDL == NULL) {
+static void SN_delete(STF_Pool *pool, SN *stringNode) {
+  if(stringNode->value != NULL) {
+    CL_delete(stringNode->value);
+  }
+  _SN_freeChars(stringNode);
+  if(pool == NULL) {
+    STF_release(stringNode);
+  }else {
+    STF_Pool_free(pool, stringNode);
+  }
+}
+
+static bool SN_setChars(SN *stringNode, String chars, int length, STF_Intern *intern) {
+  // chars may be the node's own buffer, so short ones are copied aside before it's released
+  char shortChars[STF_SHORT_LENGTH];
+  bool isShort = intern == NULL && length < STF_SHORT_LENGTH;
+  String newChars = intern != NULL ? STF_intern(intern, chars, length) :
+    isShort ? shortChars : (String)STF_malloc(length + 1);
+  if(newChars == NULL) {
     return false;
+  }else if(intern == NULL) {
+    memcpy(newChars, chars, length);
+    newChars[length] = '\0';
   }
-  DN *tmpNode = list->start;
-  for(int i = 0;i < list->size; i++) {
-    if(!DL_unshift(tmpDL, tmpNode->value)) {
-      DL_delete(tmpDL);
-      return false;
+  if(stringNode->value != NULL) {
+    CL_delete(stringNode->value);
+    stringNode->value = NULL;
+  }
+  _SN_freeChars(stringNode);
+  if(isShort) {
+    memcpy(stringNode->storage.shortChars, shortChars, length + 1);
+  }else {
+    stringNode->storage.chars = newChars;
+  }
+  stringNode->isShort = isShort;
+  stringNode->isInterned = intern != NULL;
+  stringNode->length = length;
+  return true;
+}
+
+static bool SN_setList(SN *stringNode, CL *charList, STF_Intern *intern) {
+  if(charList->size < STF_SHORT_LENGTH) {
+    char shortChars[STF_SHORT_LENGTH];
+    CN *tmpNode = charList->start;
+    for(int i = 0;i < charList->size;i++) {
+      shortChars[i] = tmpNode->value;
+      tmpNode = tmpNode->next;
     }
-    tmpNode = tmpNode->next;
+    return SN_setChars(stringNode, shortChars, charList->size, intern);
   }
-  DL_clear(list);
-  list->start = tmpDL->start;
-  list->end = tmpDL->end;
-  list->size = tmpDL->size;
-  free(tmpDL);
+  String newChars = _CL_chars(charList, false);
+  if(newChars == NULL) {
+    return false;
+  }else if(intern != NULL) {
+    bool isSet = SN_setChars(stringNode, newChars, charList->size, intern);
+    STF_release(newChars);
+    return isSet;
+  }
+  if(stringNode->value != NULL) {
+    CL_delete(stringNode->value);
+    stringNode->value = NULL;
+  }
+  _SN_freeChars(stringNode);
+  stringNode->storage.chars = newChars;
+  stringNode->isInterned = false;
+  stringNode->length = charList->size;
   return true;
 }
 
-DL * DL_slice(DL *list, int start, int end) {
-  if(start >= list->size || start < 0 || end <= start) {
+static SN * SN_createFrom(STF_Pool *pool, String chars, int length, STF_Intern *intern) {
+  SN *stringNode = (SN *)(pool == NULL ? STF_malloc(sizeof(SN)) : STF_Pool_alloc(pool));
+  if(stringNode == NULL) {
     return NULL;
   }
-  DL *listSub = DL_create();
-  if(listSub == NULL) {
+  stringNode->value = NULL;
+  stringNode->next = NULL;
+  stringNode->storage.chars = NULL;
+  stringNode->isShort = false;
+  stringNode->isInterned = false;
+  if(!SN_setChars(stringNode, chars, length, intern)) {
+    SN_delete(pool, stringNode);
     return NULL;
   }
-  DN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i >= start && i < end) {
-      if(!DL_add(listSub, tmpNode->value)) {
-        DL_delete(listSub);
-        return NULL;
-      }
-    }
-    if(i == end - 1) {
-      return listSub;
-    }
-    tmpNode = tmpNode->next;
-  }
-  return listSub;
+  return stringNode;
 }
 
-DL * DL_sub(DL *list, int start, int length) {
-  if(start >= list->size || start < 0 || length < 1) {
+static SN * SN_create(STF_Pool *pool, String array, STF_Intern *intern) {
+  return SN_createFrom(pool, array, strlen(array), intern);
+}
+
+static SN * SN_createFromList(STF_Pool *pool, CL *charList, STF_Intern *intern) {
+  SN *stringNode = (SN *)(pool == NULL ? STF_malloc(sizeof(SN)) : STF_Pool_alloc(pool));
+  if(stringNode == NULL) {
     return NULL;
   }
-  DL *listSub = DL_create();
-  if(listSub == NULL) {
+  stringNode->value = NULL;
+  stringNode->next = NULL;
+  stringNode->storage.chars = NULL;
+  stringNode->isShort = false;
+  stringNode->isInterned = false;
+  if(!SN_setList(stringNode, charList, intern)) {
+    SN_delete(pool, stringNode);
     return NULL;
   }
-  DN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i >= start && i < start + length) {
-      if(!DL_add(listSub, tmpNode->value)) {
-        DL_delete(listSub);
-        return NULL;
-      }
-    }
-    if(i > start + length - 1) {
-      return listSub;
+  return stringNode;
+}
+
+static CL * SN_toList(SN *stringNode) {
+  if(stringNode->value != NULL) {
+    return stringNode->value;
+  }
+  CL *charList = CL_create();
+  if(charList == NULL) {
+    return NULL;
+  }
+  for(int i = 0;i < stringNode->length;i++) {
+    if(!CL_add(charList, _SN_buffer(stringNode)[i])) {
+      CL_delete(charList);
+      return NULL;
     }
-    tmpNode = tmpNode->next;
   }
-  return listSub;
+  // an interned node keeps its key so it still knows which pool to go back to
+  if(!stringNode->isInterned) {
+    _SN_freeChars(stringNode);
+  }
+  stringNode->value = charList;
+  return charList;
 }
 
-bool DL_startsWith(DL *list, double v) {
-  return list->size > 0 && list->start->value == v;
+static String SN_chars(SN *stringNode) {
+  if(stringNode->value != NULL) {
+    CL *charList = stringNode->value;
+    stringNode->value = NULL;
+    if(!SN_setList(stringNode, charList, _SN_intern(stringNode))) {
+      stringNode->value = charList;
+      return NULL;
+    }
+    CL_delete(charList);
+  }
+  return _SN_buffer(stringNode);
 }
 
-bool DL_endsWith(DL *list, double v) {
-  return list->size == 1 && list->start->value == v || 
-    list->size > 0 && list->end->value == v;
+static bool SN_equalsArray(SN *stringNode, String array, int length) {
+  String chars = SN_chars(stringNode);
+  return chars != NULL && stringNode->length == length && memcmp(chars, array, length) == 0;
 }
 
-bool DL_contains(DL * list, double v) {
-  DN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      return true;
+static bool SN_equalsList(SN *stringNode, CL *charList) {
+  String chars = SN_chars(stringNode);
+  if(chars == NULL || stringNode->length != charList->size) {
+    return false;
+  }
+  CN *tmpNode = charList->start;
+  for(int i = 0;i < stringNode->length;i++) {
+    if(chars[i] != tmpNode->value) {
+      return false;
     }
     tmpNode = tmpNode->next;
   }
-  return false;
+  return true;
 }
 
-bool DL_isEmpty(DL *list) {
-  return list->size == 0 ? 1 : 0;
+static bool SN_equalsKey(SN *stringNode, STF_Intern *intern, String key, String array, int length) {
+  // an interned string only has one copy per pool so the addresses tell it all
+  if(intern != NULL && stringNode->value == NULL && _SN_intern(stringNode) == intern) {
+    return stringNode->storage.chars == key;
+  }
+  return SN_equalsArray(stringNode, array, length);
 }
 
-int DL_compare(DL *listA, DL *listB) {
-  int len = listA->size > listB->size ? listB->size : listA->size;
-  DN *tmpNodeA = listA->start;
-  DN *tmpNodeB = listB->start;
+static bool SN_equals(SN *stringNodeA, SN *stringNodeB) {
+  if(stringNodeA->isInterned && stringNodeB->isInterned && stringNodeA->value == NULL && stringNodeB->value == NULL &&
+    _SN_intern(stringNodeA) == _SN_intern(stringNodeB)) {
+    return stringNodeA->storage.chars == stringNodeB->storage.chars;
+  }
+  String chars = SN_chars(stringNodeB);
+  return chars != NULL && SN_equalsArray(stringNodeA, chars, stringNodeB->length);
+}
+
+static int SN_compare(SN *stringNodeA, SN *stringNodeB) {
+  String charsA = SN_chars(stringNodeA), charsB = SN_chars(stringNodeB);
+  if(charsA == NULL || charsB == NULL) {
+    return 0;
+  }
+  int len = stringNodeA->length > stringNodeB->length ? stringNodeB->length : stringNodeA->length;
   for(int i = 0;i < len;i++) {
-    if(tmpNodeA->value < tmpNodeB->value) {
+    if(charsA[i] < charsB[i]) {
       return 1;
-    }else if(tmpNodeA->value > tmpNodeB->value) {
+    }else if(charsA[i] > charsB[i]) {
       return -1;
     }
-    tmpNodeA = tmpNodeA->next;
-    tmpNodeB = tmpNodeB->next;
   }
-  if(listA->size > listB->size) return -1;
-  else if(listA->size < listB->size) return 1;
+  if(stringNodeA->length > stringNodeB->length) return -1;
+  else if(stringNodeA->length < stringNodeB->length) return 1;
   return 0;
 }
 
-bool DL_equalsList(DL *listA, DL *listB) {
-  return DL_compare(listA, listB) == 0;
+static SN * SL_getNode(SL * list, int index) {
+  if(index < 0 || index >= list->size) {
+    return NULL;
+  }
+  if(list->isIndexed || _SL_index(list)) {
+    return list->nodes[list->offset + index];
+  }
+  SN *tmpNode = list->start;
+  for(int i = 0;i < index;i++) {
+    tmpNode = tmpNode->next;
+  }
+  return tmpNode;
+}
+
+static bool _SL_reserve(SL *list, int capacity) {
+  if(list->offset + capacity <= list->capacity) {
+    return true;
+  }
+  // slide the table back to the beginning before growing it
+  if(list->isIndexed && list->offset > 0) {
+    memmove(list->nodes, list->nodes + list->offset, list->size * sizeof(SN *));
+  }
+  list->offset = 0;
+  if(capacity <= list->capacity) {
+    return true;
+  }
+  int newCapacity = list->capacity == 0 ? 16 : list->capacity;
+  while(newCapacity < capacity) {
+    newCapacity *= 2;
+  }
+  SN **nodes = (SN **)STF_reallocWith(STF_Pool_allocator(list->pool), list->nodes, newCapacity * sizeof(SN *));
+  if(nodes == NULL) {
+    return false;
+  }
+  list->nodes = nodes;
+  list->capacity = newCapacity;
+  return true;
 }
 
-bool DL_equalsArray(DL *list, double *array, int len) {
-  if(list->size != len) {
+static bool _SL_index(SL *list) {
+  // a view shares the nodes of another list and never owns a table
+  if(list->isView) {
     return false;
   }
-  DN *tmpNode = list->start;
+  list->offset = 0;
+  if(!_SL_reserve(list, list->size)) {
+    return false;
+  }
+  SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value != array[i]) {
-      return false;
-    }
+    list->nodes[i] = tmpNode;
     tmpNode = tmpNode->next;
   }
+  list->isIndexed = true;
   return true;
 }
 
-bool DL_isSame(DL *listA, DL *listB) {
-  return listA == listB;
-}
-
-int DL_indexOf(DL * list, double v) {
-  DN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      return i;
+static void _SL_indexInsert(SL *list, SN *node, int index) {
+  if(!list->isIndexed) {
+    return;
+  }
+  if(index < list->size / 2 && list->offset > 0) {
+    list->offset--;
+    memmove(list->nodes + list->offset, list->nodes + list->offset + 1, index * sizeof(SN *));
+  }else if(index == 0) {
+    // no room in front of the table, it's cheaper to rebuild it when needed
+    list->isIndexed = false;
+    return;
+  }else {
+    if(!_SL_reserve(list, list->size + 1)) {
+      list->isIndexed = false;
+      return;
     }
-    tmpNode = tmpNode->next;
+    memmove(list->nodes + list->offset + index + 1, list->nodes + list->offset + index,
+      (list->size - index) * sizeof(SN *));
   }
-  return -1;
+  list->nodes[list->offset + index] = node;
 }
 
-int DL_lastIndexOf(DL * list, double v) {
-  DN *tmpNode = list->start;
-  int index = -1;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      index = i;
-    }
-    tmpNode = tmpNode->next;
+static void _SL_indexRemove(SL *list, int index) {
+  if(!list->isIndexed || index >= list->size) {
+    return;
+  }
+  if(index < list->size / 2) {
+    memmove(list->nodes + list->offset + 1, list->nodes + list->offset, index * sizeof(SN *));
+    list->offset++;
+  }else {
+    memmove(list->nodes + list->offset + index, list->nodes + list->offset + index + 1,
+      (list->size - index - 1) * sizeof(SN *));
   }
-  return index;
 }
 
-int DL_count(DL *list, double v) {
-  DN *tmpNode = list->start;
-  int n = 0;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == v) {
-      n++;
+static bool _SL_append(SL *list, String *array, SN *source, int len) {
+  if(len <= 0) {
+    return true;
+  }else if(list->pool != NULL && !STF_Pool_reserve(list->pool, len)) {
+    return false;
+  }
+  SN *first = NULL, *last = NULL;
+  bool isOrdered = true;
+  for(int i = 0;i < len;i++) {
+    SN *stringNode = array != NULL ? SN_create(list->pool, array[i], list->intern) :
+      SN_chars(source) == NULL ? NULL : SN_createFrom(list->pool, _SN_buffer(source), source->length, list->intern);
+    if(stringNode == NULL) {
+      while(first != NULL) {
+        SN *tmpNode = first->next;
+        SN_delete(list->pool, first);
+        first = tmpNode;
+      }
+      return false;
+    }
+    if(list->isSorted && (last == NULL ? list->size > 0 && SN_compare(list->end, stringNode) == -1 : SN_compare(last, stringNode) == -1)) {
+      isOrdered = false;
+    }
+    if(first == NULL) {
+      first = stringNode;
+    }else {
+      last->next = stringNode;
+    }
+    last = stringNode;
+    if(array == NULL) {
+      source = source->next;
     }
-    tmpNode = tmpNode->next;
   }
-  return n;
-}
-
-void DL_fill(DL *list, double v) {
-  DN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    tmpNode->value = v;
-    tmpNode = tmpNode->next;
+  if(list->size == 0) {
+    list->start = first;
+  }else {
+    list->end->next = first;
   }
-}
-
-void DL_replace(DL *list, double oldValue, double newValue) {
-  DN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(tmpNode->value == oldValue) {
-      tmpNode->value = newValue;
+  list->end = last;
+  if(list->isIndexed && _SL_reserve(list, list->size + len)) {
+    SN **nodes = list->nodes + list->offset + list->size;
+    for(SN *tmpNode = first;tmpNode != NULL;tmpNode = tmpNode->next) {
+      *nodes++ = tmpNode;
+    }
+  }else {
+    list->isIndexed = false;
+  }
+  list->size += len;
+  list->isSorted = list->isSorted && isOrdered;
+  if(list->hash != NULL) {
+    for(SN *tmpNode = first;tmpNode != NULL;tmpNode = tmpNode->next) {
+      _SL_hashAdd(list, tmpNode);
     }
-    tmpNode = tmpNode->next;
   }
+  return true;
 }
 
-void DL_print(DL *list) {
-  DN *tmpNode = list->start;
-  printf("{");
-  for(int i = 0;i < list->size;i++) {
-    printf("%.2lf", tmpNode->value);
-    tmpNode = tmpNode->next;
-    i != list->size - 1 && printf(", ");
+SL * SL_create() {
+  SL *list = (SL *)STF_malloc(sizeof(SL));
+  if(list == NULL) {
+    return NULL;
   }
-  printf("}");
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->pool = NULL;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->isView = false;
+  list->isSorted = true;
+  list->hash = NULL;
+  list->intern = NULL;
+  return list;
 }
 
-void DL_forEach(DL *list, void (*cb)(DL *, DN *, int)) {
-  DN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    cb(list, tmpNode, i);
-    tmpNode = tmpNode->next;
+SL * SL_createPooled() {
+  SL *list = SL_create();
+  if(list == NULL) {
+    return NULL;
   }
+  list->pool = STF_Pool_create(sizeof(SN));
+  if(list->pool == NULL) {
+    STF_release(list);
+    return NULL;
+  }
+  return list;
 }
 
-DL * DL_map(DL *list, double (*cb)(DL *, DN *, int)) {
-  DL *newDL = DL_create();
-  if(newDL == NULL) {
+SL * SL_createIn(STF_Arena *arena) {
+  SL *list = (SL *)STF_Arena_alloc(arena, sizeof(SL));
+  if(list == NULL) {
     return NULL;
-  }  
-  DN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(!DL_add(newDL, cb(list, tmpNode, i))) {
-      DL_delete(newDL);
-      return NULL;
-    }
-    tmpNode = tmpNode->next;
   }
-  return newDL;
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->isView = false;
+  list->isSorted = true;
+  list->hash = NULL;
+  list->intern = NULL;
+  // the list is only tracked once it can be deleted like any arena list
+  list->pool = STF_Pool_createIn(arena, NULL, sizeof(SN));
+  if(list->pool == NULL || !_STF_Arena_track(arena, list, 'S')) {
+    return NULL;
+  }
+  return list;
 }
 
-DL * DL_filter(DL *list, bool (*cb)(DL *, DN *, int)) {
-  DL *newDL = DL_create();
-  if(newDL == NULL) {
+SL * SL_createWith(const STF_Allocator *allocator) {
+  SL *list = (SL *)STF_allocWith(allocator, sizeof(SL));
+  if(list == NULL) {
     return NULL;
   }
-  DN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(!cb(list, tmpNode, i)) {
-      tmpNode = tmpNode->next;
-      continue;
-    }
-    if(!DL_add(newDL, tmpNode->value)) {
-      DL_delete(newDL);
-      return NULL;
-    }
-    tmpNode = tmpNode->next;
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->offset = 0;
+  list->isIndexed = false;
+  list->isView = false;
+  list->isSorted = true;
+  list->hash = NULL;
+  list->intern = NULL;
+  list->pool = STF_Pool_createIn(NULL, allocator, sizeof(SN));
+  if(list->pool == NULL) {
+    STF_freeWith(allocator, list);
+    return NULL;
   }
-  return newDL;
+  return list;
 }
 
-bool DL_every(DL *list, bool (*cb)(DL *, DN *, int)) {
-  DN *tmpNode = list->start;
+bool SL_compact(SL *list) {
+  if(list->isView) {
+    return false;
+  }else if(list->size == 0) {
+    return true;
+  }
+  STF_Pool *pool = STF_Pool_createLike(list->pool, sizeof(SN));
+  if(pool == NULL || !STF_Pool_grow(pool, list->size)) {
+    STF_Pool_delete(pool);
+    return false;
+  }
+  SN *tmpNode = list->start, *lastNode = NULL;
   for(int i = 0;i < list->size;i++) {
-    if(!cb(list, tmpNode, i)) {
-      return false;
+    SN *newNode = (SN *)STF_Pool_alloc(pool);
+    *newNode = *tmpNode;
+    if(lastNode == NULL) {
+      list->start = newNode;
+    }else {
+      lastNode->next = newNode;
     }
-    tmpNode = tmpNode->next;
+    if(list->isIndexed) {
+      list->nodes[list->offset + i] = newNode;
+    }
+    lastNode = newNode;
+    SN *nextNode = tmpNode->next;
+    if(list->pool == NULL) {
+      STF_release(tmpNode);
+    }
+    tmpNode = nextNode;
   }
+  list->end = lastNode;
+  // every node of a pooled list lives in its chunks, so the old pool can go at once
+  STF_Pool_delete(list->pool);
+  list->pool = pool;
+  _SL_hashInvalidate(list);
   return true;
 }
+static void _SL_hashAdd(SL *list, SN *stringNode) {
+  if(list->hash == NULL || list->hash->isStale) {
+    return;
+  }
+  String chars = SN_chars(stringNode);
+  if(chars == NULL || STF_Hash_add(list->hash, chars, stringNode->length) == NULL) {
+    list->hash->isStale = true;
+  }
+}
 
-/*--------######################################################################################--------*/
-/*--------#--******--******--******--******--**  **--******----**    --******--******--******--#--------*/
-/*--------#--******--******--******--******--**  **--******----**    --******--******--******--#--------*/
-/*--------#--**    --  **  --**  **--  **  --*** **--**    ----**    --  **  --**    --  **  --#--------*/
-/*--------#--******--  **  --******--  **  --******--**    ----**    --  **  --******--  **  --#--------*/
-/*--------#--******--  **  --****  --  **  --******--** ***----**    --  **  --******--  **  --#--------*/
-/*--------#--    **--  **  --******--  **  --** ***--**  **----**    --  **  --    **--  **  --#--------*/
-/*--------#--******--  **  --**  **--******--**  **--******----******--******--******--  **  --#--------*/
-/*--------#--******----**----**  **--******--**  **--******----******--******--******--  **  --#--------*/
-/*--------######################################################################################--------*/
-
-static void SN_delete(SN *stringNode) {
-  CL_delete(stringNode->value);
-  free(stringNode);
+static void _SL_hashRemove(SL *list, SN *stringNode) {
+  if(list->hash == NULL || list->hash->isStale) {
+    return;
+  }
+  String chars = SN_chars(stringNode);
+  if(chars == NULL || list->hash->size == 0) {
+    list->hash->isStale = true;
+    return;
+  }
+  STF_HashEntry *entry = STF_Hash_find(list->hash, chars, stringNode->length, STF_hash(chars, stringNode->length));
+  if(entry->chars == NULL || (entry->chars == chars && entry->count > 1)) {
+    // the other copies of the string can't take over the key without a search
+    list->hash->isStale = true;
+  }else {
+    STF_Hash_removeEntry(list->hash, entry);
+  }
 }
 
-static SN * SN_create(String array) {
-  SN *stringNode = (SN *)malloc(sizeof(SN));
-  CL *v = CL_createFrom(array);
-  if(stringNode == NULL) {
-    return NULL;
-  }else if(v ==  NULL) {
-    SN_delete(stringNode);
+static void _SL_hashInvalidate(SL *list) {
+  if(list->hash != NULL) {
+    list->hash->isStale = true;
   }
-  stringNode->value = v;
-  stringNode->next = NULL;
-  return stringNode;
 }
 
-static SN * SN_createFromList(CL *charList) {
-  SN *stringNode = (SN *)malloc(sizeof(SN));
-  CL *charListCopy = CL_copy(charList);
-  if(stringNode == NULL) {
-    return NULL;
-  }else if(charListCopy == NULL) {
-    SN_delete(stringNode);
-    return NULL;
+static bool _SL_hashReady(SL *list) {
+  if(list->hash == NULL) {
+    return false;
+  }else if(list->hash->isStale) {
+    STF_Hash_clear(list->hash);
+    list->hash->isStale = false;
+    SN *tmpNode = list->start;
+    for(int i = 0;i < list->size && !list->hash->isStale;i++) {
+      _SL_hashAdd(list, tmpNode);
+      tmpNode = tmpNode->next;
+    }
   }
-  stringNode->value = charListCopy;
-  stringNode->next = NULL;
-  return stringNode;
+  return !list->hash->isStale;
 }
 
-static SN * SL_getNode(SL * list, int index) {
-  if(index < 0 || index >= list->size) {
-    return NULL;
+static bool _SL_setChars(SL *list, SN *stringNode, String chars, int length) {
+  _SL_hashRemove(list, stringNode);
+  bool isSet = SN_setChars(stringNode, chars, length, list->intern);
+  _SL_hashAdd(list, stringNode);
+  return isSet;
+}
+
+static bool _SL_setList(SL *list, SN *stringNode, CL *charList) {
+  _SL_hashRemove(list, stringNode);
+  bool isSet = SN_setList(stringNode, charList, list->intern);
+  _SL_hashAdd(list, stringNode);
+  return isSet;
+}
+
+bool SL_enableHash(SL *list) {
+  if(list->hash == NULL) {
+    list->hash = STF_Hash_create(STF_Pool_allocator(list->pool), false);
+    if(list->hash == NULL) {
+      return false;
+    }
+    list->hash->isStale = true;
   }
+  return _SL_hashReady(list);
+}
+
+void SL_disableHash(SL *list) {
+  STF_Hash_delete(list->hash);
+  list->hash = NULL;
+}
+
+bool SL_enableInterning(SL *list, STF_Intern *intern) {
+  list->intern = intern;
+  _SL_hashInvalidate(list);
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(i == index) {
-      return tmpNode;
+    if(!SN_setInterned(tmpNode, intern)) {
+      return false;
     }
     tmpNode = tmpNode->next;
   }
+  return true;
 }
 
-SL * SL_create() {
-  SL *list = (SL *)malloc(sizeof(SL));
-  if(list == NULL) {
-    return NULL;
+bool SL_disableInterning(SL *list) {
+  list->intern = NULL;
+  _SL_hashInvalidate(list);
+  SN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    if(!SN_setInterned(tmpNode, NULL)) {
+      return false;
+    }
+    tmpNode = tmpNode->next;
   }
-  list->start = list->end = NULL;
-  list->size = 0;
-  return list;
+  return true;
 }
 
-bool SL_addArray(SL *list, String array) {
-  SN *stringNode = SN_create(array);
+
+static bool _SL_addChars(SL *list, String chars, int length) {
+  SN *stringNode = SN_createFrom(list->pool, chars, length, list->intern);
   if(stringNode == NULL) {
     return false;
   }
+  if(list->isSorted && list->size > 0 && SN_compare(list->end, stringNode) == -1) {
+    list->isSorted = false;
+  }
   if(list->size == 0) {
     list->start = list->end = stringNode;
   }else if(list->size == 1) {
@@ -2316,15 +5755,24 @@ bool SL_addArray(SL *list, String array) {
     list->end->next = stringNode;
     list->end = list->end->next;
   }
+  _SL_indexInsert(list, stringNode, list->size);
+  _SL_hashAdd(list, stringNode);
   list->size++;
   return true;
 }
 
+bool SL_addArray(SL *list, String array) {
+  return _SL_addChars(list, array, strlen(array));
+}
+
 bool SL_addList(SL *list, CL *v) {
-  SN *stringNode = SN_createFromList(v);
+  SN *stringNode = SN_createFromList(list->pool, v, list->intern);
   if(stringNode == NULL) {
     return false;
   }
+  if(list->isSorted && list->size > 0 && SN_compare(list->end, stringNode) == -1) {
+    list->isSorted = false;
+  }
   if(list->size == 0) {
     list->start = list->end = stringNode;
   }else if(list->size == 1) {
@@ -2333,15 +5781,20 @@ bool SL_addList(SL *list, CL *v) {
     list->end->next = stringNode;
     list->end = list->end->next;
   }
+  _SL_indexInsert(list, stringNode, list->size);
+  _SL_hashAdd(list, stringNode);
   list->size++;
   return true;
 }
 
 bool SL_unshiftArray(SL *list, String array) {
-  SN *stringNode = SN_create(array);
+  SN *stringNode = SN_create(list->pool, array, list->intern);
   if(stringNode == NULL) {
     return false;
   }
+  if(list->isSorted && list->size > 0 && SN_compare(stringNode, list->start) == -1) {
+    list->isSorted = false;
+  }
   if(list->size == 0) {
     list->start = list->end = stringNode;
   }else if(list->size == 1) {
@@ -2352,15 +5805,20 @@ bool SL_unshiftArray(SL *list, String array) {
     list->start = stringNode;
     list->start->next = tmpNode;
   }
+  _SL_indexInsert(list, stringNode, 0);
+  _SL_hashAdd(list, stringNode);
   list->size++;
   return true;
 }
 
 bool SL_unshiftList(SL *list, CL *v) {
-  SN *stringNode = SN_createFromList(v);
+  SN *stringNode = SN_createFromList(list->pool, v, list->intern);
   if(stringNode == NULL) {
     return false;
   }
+  if(list->isSorted && list->size > 0 && SN_compare(stringNode, list->start) == -1) {
+    list->isSorted = false;
+  }
   if(list->size == 0) {
     list->start = list->end = stringNode;
   }else if(list->size == 1) {
@@ -2371,36 +5829,46 @@ bool SL_unshiftList(SL *list, CL *v) {
     list->start = stringNode;
     list->start->next = tmpNode;
   }
+  _SL_indexInsert(list, stringNode, 0);
+  _SL_hashAdd(list, stringNode);
   list->size++;
   return true;
 }
 
 void SL_pop(SL *list) {
   if(list->size > 2) {
-    SN_delete(list->end);
-    list->end = SL_getNode(list, list->size - 2);
+    SN *previousNode = SL_getNode(list, list->size - 2);
+    _SL_hashRemove(list, list->end);
+    SN_delete(list->pool, list->end);
+    list->end = previousNode;
     list->end->next = NULL;
     list->size--;
   }else if(list->size == 2) {
-    SN_delete(list->end);
-    list->start->next = list->end = NULL;
+    _SL_hashRemove(list, list->end);
+    SN_delete(list->pool, list->end);
+    list->start->next = NULL;
+    list->end = list->start;
     list->size = 1;
   }else if(list->size == 1) {
-    SN_delete(list->start);
-    list->start = NULL;
+    _SL_hashRemove(list, list->start);
+    SN_delete(list->pool, list->start);
+    list->start = list->end = NULL;
     list->size = 0;
   }
 }
 
 void SL_shift(SL * list) {
+  _SL_indexRemove(list, 0);
   if(list->size > 1) {
     SN *tmpNode = list->start->next;
-    SN_delete(list->start);
+    _SL_hashRemove(list, list->start);
+    SN_delete(list->pool, list->start);
     list->start = tmpNode;
     list->size--;
   }else if(list->size == 1) {
-    SN_delete(list->start);
-    list->start = NULL;
+    _SL_hashRemove(list, list->start);
+    SN_delete(list->pool, list->start);
+    list->start = list->end = NULL;
     list->size = 0;
   }
 }
@@ -2415,10 +5883,15 @@ bool SL_insertList(SL *list, CL *v, int index) {
     if(!SL_addList(list, v)) return false;
   }else {
     SN *previousNode = SL_getNode(list, index - 1);
-    SN *currentNode = SN_createFromList(v);
+    SN *currentNode = SN_createFromList(list->pool, v, list->intern);
     if(currentNode == NULL) return false;
+    if(list->isSorted && (SN_compare(previousNode, currentNode) == -1 || SN_compare(currentNode, previousNode->next) == -1)) {
+      list->isSorted = false;
+    }
     currentNode->next = previousNode->next;
     previousNode->next = currentNode;
+    _SL_indexInsert(list, currentNode, index);
+    _SL_hashAdd(list, currentNode);
     list->size++;
   }
   return true;
@@ -2434,10 +5907,15 @@ bool SL_insertArray(SL *list, String array, int index) {
     if(!SL_addArray(list, array)) return false;
   }else {
     SN *previousNode = SL_getNode(list, index - 1);
-    SN *currentNode = SN_create(array);
+    SN *currentNode = SN_create(list->pool, array, list->intern);
     if(currentNode == NULL) return false;
+    if(list->isSorted && (SN_compare(previousNode, currentNode) == -1 || SN_compare(currentNode, previousNode->next) == -1)) {
+      list->isSorted = false;
+    }
     currentNode->next = previousNode->next;
     previousNode->next = currentNode;
+    _SL_indexInsert(list, currentNode, index);
+    _SL_hashAdd(list, currentNode);
     list->size++;
   }
   return true;
@@ -2453,193 +5931,454 @@ void SL_remove(SL *list, int index) {
       SN *previousNode = SL_getNode(list, index - 1);
       SN *currentNode = previousNode->next;
       previousNode->next = currentNode->next;
-      SN_delete(currentNode);
+      _SL_hashRemove(list, currentNode);
+      SN_delete(list->pool, currentNode);
+      _SL_indexRemove(list, index);
       list->size--;
     }
   }
 }
 
 void SL_clear(SL *list) {
-  for(int i = 0, size = list->size;i < size;i++) {
-    SL_shift(list);
+  if(!list->isView) {
+    SN *tmpNode = list->start;
+    for(int i = 0;i < list->size;i++) {
+      SN *nextNode = tmpNode->next;
+      if(tmpNode->value != NULL) {
+        CL_delete(tmpNode->value);
+      }
+      _SN_freeChars(tmpNode);
+      if(list->pool == NULL) {
+        STF_release(tmpNode);
+      }
+      tmpNode = nextNode;
+    }
+    if(list->pool != NULL) {
+      STF_Pool_reset(list->pool);
+    }
+  }
+  list->start = list->end = NULL;
+  list->size = 0;
+  list->offset = 0;
+  list->isSorted = true;
+  if(list->hash != NULL) {
+    STF_Hash_clear(list->hash);
+    list->hash->isStale = false;
   }
 }
 
 void SL_delete(SL *list) {
+  // a list made in an arena keeps its header until the arena is reset
+  bool isInArena = list->pool != NULL && list->pool->arena != NULL;
+  const STF_Allocator *allocator = STF_Pool_allocator(list->pool);
   SL_clear(list);
-  free(list);
+  STF_Pool_delete(list->pool);
+  STF_freeWith(allocator, list->nodes);
+  STF_Hash_delete(list->hash);
+  if(isInArena) {
+    list->nodes = NULL;
+    list->capacity = 0;
+    list->isIndexed = false;
+    list->hash = NULL;
+    return;
+  }
+  STF_freeWith(allocator, list);
 }
 
 bool SL_setArray(SL * list, String array, int index) {
-  if(!(index >= 0 && index < list->size)) {
-    return false;
-  }
-  CL *newCL = CL_createFrom(array);
-  if(newCL == NULL) {
-    return false;
-  }
-  if(index == 0) {
-    CL_delete(list->start->value);
-    list->start->value = newCL;
-  }else if(index == list->size - 1) {
-    CL_delete(list->end->value);
-    list->end->value = newCL;
-  }else {
-    SN *tmpNode = SL_getNode(list, index);
-    CL_delete(tmpNode->value);
-    tmpNode->value = newCL;
-  }
-  return true;
+  list->isSorted = false;
+  SN *tmpNode = SL_getNode(list, index);
+  return tmpNode != NULL && _SL_setChars(list, tmpNode, array, strlen(array));
 }
 
 bool SL_setList(SL * list, CL *v, int index) {
-  if(!(index >= 0 && index < list->size)) {
-    return false;
-  }
-  CL *newCL = CL_copy(v);
-  if(index == 0) {
-    CL_delete(list->start->value);
-    list->start->value = newCL;
-  }else if(index == list->size - 1) {
-    CL_delete(list->end->value);
-    list->end->value = newCL;
-  }else {
-    SN *tmpNode = SL_getNode(list, index);
-    CL_delete(tmpNode->value);
-    tmpNode->value = newCL;
-  }
-  return true;
+  list->isSorted = false;
+  SN *tmpNode = SL_getNode(list, index);
+  return tmpNode != NULL && _SL_setList(list, tmpNode, v);
 }
 
 String SL_get(SL * list, int index) {
-  if(index < 0 || index >= list->size) {
+  SN *tmpNode = SL_getNode(list, index);
+  if(tmpNode == NULL || SN_chars(tmpNode) == NULL) {
     return NULL;
   }
-  SN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i == index) {
-      return CL_toCharArray(tmpNode->value);
-    }
-    tmpNode = tmpNode->next;
+  String array = (String)STF_mallocOut(tmpNode->length + 1);
+  if(array == NULL) {
+    return NULL;
   }
+  memcpy(array, _SN_buffer(tmpNode), tmpNode->length + 1);
+  return array;
 }
 
 void SL_toLowerCase(SL *list) {
+  list->isSorted = false;
+  _SL_hashInvalidate(list);
+  unsigned char table[256];
+  STF_caseTable(table, false);
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    CL_toLowerCase(tmpNode->value);
+    String chars = SN_setInterned(tmpNode, NULL) ? SN_chars(tmpNode) : NULL;
+    for(int j = 0;chars != NULL && j < tmpNode->length;j++) {
+      chars[j] = table[(unsigned char)chars[j]];
+    }
+    SN_setInterned(tmpNode, list->intern);
     tmpNode = tmpNode->next;
   }
 }
 
 void SL_toUpperCase(SL *list) {
+  list->isSorted = false;
+  _SL_hashInvalidate(list);
+  unsigned char table[256];
+  STF_caseTable(table, true);
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    CL_toUpperCase(tmpNode->value);
+    String chars = SN_setInterned(tmpNode, NULL) ? SN_chars(tmpNode) : NULL;
+    for(int j = 0;chars != NULL && j < tmpNode->length;j++) {
+      chars[j] = table[(unsigned char)chars[j]];
+    }
+    SN_setInterned(tmpNode, list->intern);
     tmpNode = tmpNode->next;
   }
 }
 
 void SL_capitalize(SL *list) {
+  list->isSorted = false;
+  _SL_hashInvalidate(list);
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    CL_capitalize(tmpNode->value);
+    String chars = SN_setInterned(tmpNode, NULL) ? SN_chars(tmpNode) : NULL;
+    if(chars != NULL && tmpNode->length > 0) {
+      chars[0] = toupper(chars[0]);
+    }
+    SN_setInterned(tmpNode, list->intern);
     tmpNode = tmpNode->next;
   }
 }
 
-static void _SL_sort(SL *list, bool isReversed) {
-  SN *currentNode, *previousNode;
-  bool difference;
-  loopAgain:
-    difference = false;
-    currentNode = previousNode = list->start;
-    for(int i = 0;i < list->size;i++) {
-      currentNode = currentNode->next;
-      if(currentNode != NULL && (isReversed ? CL_compare(previousNode->value, currentNode->value) == 1 :
-          CL_compare(previousNode->value, currentNode->value) == -1)) {
-        CL *c = currentNode->value;
-        currentNode->value = previousNode->value;
-        previousNode->value = c;
-        difference = true;
+static int _SK_charAt(SK *key, int depth) {
+  return depth < key->length ? key->chars[depth] - CHAR_MIN + 1 : 0;
+}
+
+static void _SK_sort(SK *keys, int len, int depth) {
+  while(len > 1) {
+    if(len < 10) {
+      for(int i = 1;i < len;i++) {
+        for(int j = i;j > 0;j--) {
+          int d = depth, a, b;
+          do {
+            a = _SK_charAt(&keys[j - 1], d);
+            b = _SK_charAt(&keys[j], d);
+            d++;
+          }while(a == b && a != 0);
+          if(a <= b) {
+            break;
+          }
+          SK tmpKey = keys[j];
+          keys[j] = keys[j - 1];
+          keys[j - 1] = tmpKey;
+        }
+      }
+      return;
+    }
+    int a = _SK_charAt(&keys[0], depth), b = _SK_charAt(&keys[len / 2], depth),
+      c = _SK_charAt(&keys[len - 1], depth);
+    int pivot = a < b ? (b < c ? b : a < c ? c : a) : (a < c ? a : b < c ? c : b);
+    int lt = 0, i = 0, gt = len - 1;
+    while(i <= gt) {
+      int v = _SK_charAt(&keys[i], depth);
+      SK tmpKey = keys[i];
+      if(v < pivot) {
+        keys[i++] = keys[lt];
+        keys[lt++] = tmpKey;
+      }else if(v > pivot) {
+        keys[i] = keys[gt];
+        keys[gt--] = tmpKey;
+      }else {
+        i++;
+      }
+    }
+    _SK_sort(keys, lt, depth);
+    _SK_sort(keys + gt + 1, len - gt - 1, depth);
+    if(pivot == 0) {
+      return;
+    }
+    keys += lt;
+    len = gt - lt + 1;
+    depth++;
+  }
+}
+
+static void _SL_sortNodes(SL *list, bool isReversed) {
+  if(list->size < 2) {
+    return;
+  }
+  SN *start = list->start, *tail = NULL;
+  for(int width = 1;width < list->size;width *= 2) {
+    SN *left = start;
+    start = tail = NULL;
+    while(left != NULL) {
+      SN *right = left;
+      int leftSize = 0, rightSize = width;
+      while(leftSize < width && right != NULL) {
+        right = right->next;
+        leftSize++;
       }
-      previousNode = currentNode;
+      while(leftSize > 0 || (rightSize > 0 && right != NULL)) {
+        SN *tmpNode;
+        if(leftSize == 0 || (rightSize > 0 && right != NULL &&
+            SN_compare(left, right) == (isReversed ? 1 : -1))) {
+          tmpNode = right;
+          right = right->next;
+          rightSize--;
+        }else {
+          tmpNode = left;
+          left = left->next;
+          leftSize--;
+        }
+        if(tail == NULL) {
+          start = tmpNode;
+        }else {
+          tail->next = tmpNode;
+        }
+        tail = tmpNode;
+      }
+      left = right;
+    }
+    tail->next = NULL;
+  }
+  list->start = start;
+  list->end = tail;
+  list->isIndexed = false;
+}
+
+static void _SL_sort(SL *list, bool isReversed) {
+  if(list->size < 2) {
+    return;
+  }
+  SK *keys = (SK *)STF_malloc(list->size * sizeof(SK));
+  if(keys == NULL) {
+    _SL_sortNodes(list, isReversed);
+    return;
+  }
+  SN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    keys[i].chars = SN_chars(tmpNode);
+    if(keys[i].chars == NULL) {
+      STF_release(keys);
+      _SL_sortNodes(list, isReversed);
+      return;
+    }
+    keys[i].length = tmpNode->length;
+    keys[i].node = tmpNode;
+    tmpNode = tmpNode->next;
+  }
+  _SK_sort(keys, list->size, 0);
+  for(int i = 0;i < list->size;i++) {
+    tmpNode = keys[isReversed ? list->size - 1 - i : i].node;
+    if(i == 0) {
+      list->start = tmpNode;
+    }else {
+      list->end->next = tmpNode;
     }
-  if(difference) {
-    goto loopAgain;
+    list->end = tmpNode;
   }
+  list->end->next = NULL;
+  list->isIndexed = false;
+  STF_release(keys);
 }
 
 void SL_sort(SL *list) {
   _SL_sort(list, false);
+  list->isSorted = true;
 }
 
 void SL_rsort(SL *list) {
   _SL_sort(list, true);
+  list->isSorted = false;
+}
+static int _SL_compareChars(SN *stringNode, String chars, int length) {
+  String nodeChars = SN_chars(stringNode);
+  int len = stringNode->length < length ? stringNode->length : length;
+  for(int i = 0;nodeChars != NULL && i < len;i++) {
+    if(nodeChars[i] != chars[i]) {
+      return nodeChars[i] < chars[i] ? -1 : 1;
+    }
+  }
+  return stringNode->length < length ? -1 : stringNode->length > length ? 1 : 0;
+}
+
+static int _SL_bound(SL *list, String chars, int length, bool isUpper) {
+  if(!list->isIndexed && !_SL_index(list)) {
+    SN *tmpNode = list->start;
+    int index = 0;
+    while(index < list->size && _SL_compareChars(tmpNode, chars, length) < (isUpper ? 1 : 0)) {
+      tmpNode = tmpNode->next;
+      index++;
+    }
+    return index;
+  }
+  SN **nodes = list->nodes + list->offset;
+  int low = 0, high = list->size;
+  while(low < high) {
+    int middle = low + (high - low) / 2;
+    if(_SL_compareChars(nodes[middle], chars, length) < (isUpper ? 1 : 0)) {
+      low = middle + 1;
+    }else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+int SL_lowerBound(SL *list, String array) {
+  return _SL_bound(list, array, strlen(array), false);
+}
+
+int SL_upperBound(SL *list, String array) {
+  return _SL_bound(list, array, strlen(array), true);
+}
+
+int SL_binarySearch(SL *list, String array) {
+  int length = strlen(array);
+  int index = _SL_bound(list, array, length, false);
+  return index < list->size && _SL_compareChars(SL_getNode(list, index), array, length) == 0 ? index : -1;
+}
+
+bool SL_sortedInsert(SL *list, String array) {
+  return SL_insertArray(list, array, _SL_bound(list, array, strlen(array), true));
 }
 
 SL * SL_createFrom(String *array, int len) {
-  SL *list = SL_create();
+  SL *list = SL_createPooled();
   if(list == NULL) {
     return NULL;
-  }
-  int i = 0;
-  while(i < len) {
-    if(!SL_addArray(list, array[i])) {
-      SL_delete(list);
-      return NULL;
-    }
-    i++;
+  }else if(!_SL_append(list, array, NULL, len)) {
+    SL_delete(list);
+    return NULL;
   }
   return list;
 }
 
 SL * SL_copy(SL *list) {
-  SL *listCopy = SL_create();
+  SL *listCopy = SL_createPooled();
   if(listCopy == NULL) {
     return NULL;
   }
-  SN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(!SL_addList(listCopy, tmpNode->value)) {
-      SL_delete(listCopy);
-      return NULL;
-    }
-    tmpNode = tmpNode->next;
+  listCopy->intern = list->intern;
+  if(!_SL_append(listCopy, NULL, list->start, list->size)) {
+    SL_delete(listCopy);
+    return NULL;
   }
   return listCopy;
 }
 
 bool SL_concat(SL *listA, SL *listB) {
-  SN *tmpNode = listB->start;
-  for(int i = 0;i < listB->size;i++) {
-    if(!SL_addList(listA, tmpNode->value)) {
-      SL_delete(listA);
+  return _SL_append(listA, NULL, listB->start, listB->size);
+}
+static bool _SL_canSplice(SL *list, SL *other) {
+  // a view borrows the nodes of its list and a copied header shares them, moving them would free them twice
+  return list != other && !list->isView && !other->isView && (list->pool == NULL || list->pool != other->pool) &&
+    (other->start == NULL || other->start != list->start);
+}
+
+bool SL_spliceAt(SL *list, int index, SL *other) {
+  if(index < 0 || index > list->size || !_SL_canSplice(list, other)) {
+    return false;
+  }else if(other->size == 0) {
+    return true;
+  }
+  SN *first = other->start, *last = other->end;
+  int size = other->size;
+  bool isMovable = list->pool == other->pool || (list->pool != NULL && other->pool != NULL &&
+    list->pool->arena == other->pool->arena && list->pool->allocator == other->pool->allocator);
+  if(isMovable) {
+    // the nodes move as they are so their chars have to follow the interning of their new list
+    _SL_hashInvalidate(other);
+    SN *tmpNode = other->start;
+    for(int i = 0;i < other->size;i++) {
+      if(!SN_setInterned(tmpNode, list->intern)) {
+        return false;
+      }
+      tmpNode = tmpNode->next;
+    }
+    if(list->pool != other->pool) {
+      STF_Pool_merge(list->pool, other->pool);
+    }
+  }else {
+    // the nodes come from different allocators and can't change owner so copy them
+    SL tmpList = {.pool = list->pool, .intern = list->intern};
+    if(!_SL_append(&tmpList, NULL, other->start, other->size)) {
       return false;
     }
-    tmpNode = tmpNode->next;
+    SL_clear(other);
+    first = tmpList.start;
+    last = tmpList.end;
   }
+  if(index == 0) {
+    last->next = list->start;
+    list->start = first;
+  }else {
+    SN *previousNode = SL_getNode(list, index - 1);
+    last->next = previousNode->next;
+    previousNode->next = first;
+  }
+  if(index == list->size) {
+    list->end = last;
+  }
+  list->size += size;
+  list->isIndexed = false;
+  list->isSorted = false;
+  _SL_hashInvalidate(list);
+  _SL_hashInvalidate(other);
+  other->start = other->end = NULL;
+  other->size = 0;
+  other->isIndexed = false;
   return true;
 }
 
+bool SL_concatMove(SL *listA, SL *listB) {
+  return SL_spliceAt(listA, listA->size, listB);
+}
+
+
 bool SL_reverse(SL *list) {
-  SL *tmpSL = SL_create();
-  if(tmpSL == NULL) {
+  return SL_reverseRange(list, 0, list->size);
+}
+
+bool SL_reverseRange(SL *list, int start, int end) {
+  if(start < 0 || end > list->size || start > end) {
     return false;
+  }else if(end - start < 2) {
+    return true;
+  }
+  list->isSorted = false;
+  SN *previousNode = start == 0 ? NULL : SL_getNode(list, start - 1);
+  SN *first = previousNode == NULL ? list->start : previousNode->next;
+  SN *tmpNode = first, *reversed = NULL;
+  for(int i = start;i < end;i++) {
+    SN *nextNode = tmpNode->next;
+    tmpNode->next = reversed;
+    reversed = tmpNode;
+    tmpNode = nextNode;
+  }
+  first->next = tmpNode;
+  if(previousNode == NULL) {
+    list->start = reversed;
+  }else {
+    previousNode->next = reversed;
   }
-  SN *tmpNode = list->start;
-  for(int i = 0;i < list->size; i++) {
-    if(!SL_unshiftList(tmpSL, tmpNode->value)) {
-      SL_delete(tmpSL);
-      return false;
+  if(end == list->size) {
+    list->end = first;
+  }
+  if(list->isIndexed) {
+    SN **left = list->nodes + list->offset + start, **right = list->nodes + list->offset + end - 1;
+    while(left < right) {
+      SN *swapNode = *left;
+      *left++ = *right;
+      *right-- = swapNode;
     }
-    tmpNode = tmpNode->next;
   }
-  SL_clear(list);
-  list->start = tmpSL->start;
-  list->end = tmpSL->end;
-  list->size = tmpSL->size;
-  free(tmpSL);
   return true;
 }
 
@@ -2647,83 +6386,60 @@ SL * SL_slice(SL *list, int start, int end) {
   if(start >= list->size || start < 0 || end <= start) {
     return NULL;
   }
-  SL *listSub = SL_create();
-  if(listSub == NULL) {
-    return NULL;
+  SL view = SL_view(list, start, end > list->size ? list->size : end);
+  return SL_copy(&view);
+}
+
+SL SL_view(SL *list, int start, int end) {
+  SL view = {.isView = true, .isSorted = list->isSorted, .intern = list->intern};
+  if(start < 0 || end > list->size || start >= end) {
+    return view;
   }
-  SN *tmpString = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i >= start && i < end) {
-      if(!SL_addList(listSub, tmpString->value)) {
-        SL_delete(listSub);
-        return NULL;
-      }
-    }
-    if(i == end - 1) {
-      return listSub;
-    }
-    tmpString = tmpString->next;
+  view.start = SL_getNode(list, start);
+  view.end = SL_getNode(list, end - 1);
+  view.size = end - start;
+  if(list->isIndexed) {
+    view.nodes = list->nodes + list->offset + start;
+    view.capacity = view.size;
+    view.isIndexed = true;
   }
-  return listSub;
+  return view;
 }
 
 SL * SL_sub(SL *list, int start, int length) {
   if(start >= list->size || start < 0 || length < 1) {
     return NULL;
   }
-  SL *listSub = SL_create();
-  if(listSub == NULL) {
-    return NULL;
-  }
-  SN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(i >= start && i < start + length) {
-      if(!SL_addList(listSub, tmpNode->value)) {
-        SL_delete(listSub);
-        return NULL;
-      }
-    }
-    if(i == start + length - 1) {
-      return listSub;
-    }
-    tmpNode = tmpNode->next;
-  }
-  return listSub;
+  return SL_slice(list, start, length > list->size - start ? list->size : start + length);
 }
 
 bool SL_startsWithArray(SL *list, String array) {
-  return list->size > 0 && CL_equalsArray(list->start->value, array);
+  return list->size > 0 && SN_equalsArray(list->start, array, strlen(array));
 }
 
 bool SL_startsWithList(SL *list, CL *v) {
-  return list->size > 0 && CL_equalsList(list->start->value, v);
+  return list->size > 0 && SN_equalsList(list->start, v);
 }
 
 bool SL_endsWithArray(SL *list, String array) {
-  return list->size == 1 && CL_equalsArray(list->start->value, array) ||
-    list->size > 0 && CL_equalsArray(list->end->value, array);
+  return list->size > 0 && SN_equalsArray(list->end, array, strlen(array));
 }
 
 bool SL_endsWithList(SL *list, CL *v) {
-  return list->size == 1 && CL_equalsList(list->start->value, v) ||
-    list->size > 0 && CL_equalsList(list->end->value, v);
+  return list->size > 0 && SN_equalsList(list->end, v);
 }
 
 bool SL_containsArray(SL * list, String array) {
-  SN *tmpNode = list->start;
-  for(int i = 0;i < list->size;i++) {
-    if(CL_equalsArray(tmpNode->value, array)) {
-      return true;
-    }
-    tmpNode = tmpNode->next;
+  if(_SL_hashReady(list)) {
+    return STF_Hash_count(list->hash, array, strlen(array)) > 0;
   }
-  return false;
+  return SL_indexOfArray(list, array) != -1;
 }
 
 bool SL_containsList(SL * list, CL *v) {
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(CL_equalsList(tmpNode->value, v)) {
+    if(SN_equalsList(tmpNode, v)) {
       return true;
     }
     tmpNode = tmpNode->next;
@@ -2742,7 +6458,7 @@ bool SL_equals(SL *listA, SL *listB) {
   SN *tmpNodeA = listA->start;
   SN *tmpNodeB = listB->start;
   for(int i = 0;i < listA->size;i++) {
-    if(!CL_equalsList(tmpNodeA->value, tmpNodeB->value)) {
+    if(!SN_equals(tmpNodeA, tmpNodeB)) {
       return false;
     }
     tmpNodeA = tmpNodeA->next;
@@ -2752,13 +6468,22 @@ bool SL_equals(SL *listA, SL *listB) {
 }
 
 bool SL_isSame(SL *listA, SL *listB) {
-  return CL_isSame(listA->start->value, listB->start->value);
+  return listA == listB;
 }
 
 int SL_indexOfArray(SL * list, String array) {
+  int length = strlen(array);
+  if(_SL_hashReady(list) && STF_Hash_count(list->hash, array, length) == 0) {
+    return -1;
+  }
+  if(list->isSorted) {
+    int index = _SL_bound(list, array, length, false);
+    return index < list->size && _SL_compareChars(SL_getNode(list, index), array, length) == 0 ? index : -1;
+  }
+  String key = STF_internFind(list->intern, array, length);
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(CL_equalsArray(tmpNode->value, array)) {
+    if(SN_equalsKey(tmpNode, list->intern, key, array, length)) {
       return i;
     }
     tmpNode = tmpNode->next;
@@ -2769,7 +6494,7 @@ int SL_indexOfArray(SL * list, String array) {
 int SL_indexOfList(SL * list, CL *v) {
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(CL_equalsList(tmpNode->value, v)) {
+    if(SN_equalsList(tmpNode, v)) {
       return i;
     }
     tmpNode = tmpNode->next;
@@ -2778,10 +6503,27 @@ int SL_indexOfList(SL * list, CL *v) {
 }
 
 int SL_lastIndexOfArray(SL * list, String array) {
+  int length = strlen(array);
+  if(_SL_hashReady(list) && STF_Hash_count(list->hash, array, length) == 0) {
+    return -1;
+  }
+  String key = STF_internFind(list->intern, array, length);
+  if(list->isIndexed || _SL_index(list)) {
+    for(int i = list->size - 1;i >= 0;i--) {
+      if(SN_equalsKey(list->nodes[list->offset + i], list->intern, key, array, length)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+  if(list->isSorted) {
+    int index = _SL_bound(list, array, length, true) - 1;
+    return index >= 0 && _SL_compareChars(SL_getNode(list, index), array, length) == 0 ? index : -1;
+  }
   SN *tmpNode = list->start;
   int index = -1;
   for(int i = 0;i < list->size;i++) {
-    if(CL_equalsArray(tmpNode->value, array)) {
+    if(SN_equalsKey(tmpNode, list->intern, key, array, length)) {
       index = i;
     }
     tmpNode = tmpNode->next;
@@ -2790,10 +6532,18 @@ int SL_lastIndexOfArray(SL * list, String array) {
 }
 
 int SL_lastIndexOfList(SL * list, CL *v) {
+  if(list->isIndexed || _SL_index(list)) {
+    for(int i = list->size - 1;i >= 0;i--) {
+      if(SN_equalsList(list->nodes[list->offset + i], v)) {
+        return i;
+      }
+    }
+    return -1;
+  }
   SN *tmpNode = list->start;
   int index = -1;
   for(int i = 0;i < list->size;i++) {
-    if(CL_equalsList(tmpNode->value, v)) {
+    if(SN_equalsList(tmpNode, v)) {
       index = i;
     }
     tmpNode = tmpNode->next;
@@ -2802,10 +6552,18 @@ int SL_lastIndexOfList(SL * list, CL *v) {
 }
 
 int SL_countArray(SL *list, String array) {
+  int length = strlen(array);
+  if(_SL_hashReady(list)) {
+    return STF_Hash_count(list->hash, array, length);
+  }
+  if(list->isSorted) {
+    return _SL_bound(list, array, length, true) - _SL_bound(list, array, length, false);
+  }
+  String key = STF_internFind(list->intern, array, length);
   SN *tmpNode = list->start;
   int n = 0;
   for(int i = 0;i < list->size;i++) {
-    if(CL_equalsArray(tmpNode->value, array)) {
+    if(SN_equalsKey(tmpNode, list->intern, key, array, length)) {
       n++;
     }
     tmpNode = tmpNode->next;
@@ -2817,7 +6575,7 @@ int SL_countList(SL *list, CL *v) {
   SN *tmpNode = list->start;
   int n = 0;
   for(int i = 0;i < list->size;i++) {
-    if(CL_equalsList(tmpNode->value, v)) {
+    if(SN_equalsList(tmpNode, v)) {
       n++;
     }
     tmpNode = tmpNode->next;
@@ -2826,37 +6584,37 @@ int SL_countList(SL *list, CL *v) {
 }
 
 bool SL_fillArray(SL *list, String array) {
+  int length = strlen(array);
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    CL *newCL = CL_createFrom(array);
-    if(newCL == NULL) return false;
-    CL_delete(tmpNode->value);
-    tmpNode->value = newCL;
+    if(!_SL_setChars(list, tmpNode, array, length)) return false;
     tmpNode = tmpNode->next;
   }
+  list->isSorted = true;
   return true;
 }
 
 bool SL_fillList(SL *list, CL *v) {
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    CL *newCL = CL_copy(v);
-    if(newCL == NULL) return false;
-    CL_delete(tmpNode->value);
-    tmpNode->value = newCL;
+    if(!_SL_setList(list, tmpNode, v)) return false;
     tmpNode = tmpNode->next;
   }
+  list->isSorted = true;
   return true;
 }
 
 bool SL_replaceArray(SL *list, String oldValue, String newValue) {
+  list->isSorted = false;
+  int oldLength = strlen(oldValue), newLength = strlen(newValue);
+  if(_SL_hashReady(list) && STF_Hash_count(list->hash, oldValue, oldLength) == 0) {
+    return true;
+  }
+  String key = STF_internFind(list->intern, oldValue, oldLength);
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(CL_equalsArray(tmpNode->value, oldValue)) {
-      CL *newCL = CL_createFrom(newValue);
-      if(newCL == NULL) return false;
-      CL_delete(tmpNode->value);
-      tmpNode->value = newCL;
+    if(SN_equalsKey(tmpNode, list->intern, key, oldValue, oldLength)) {
+      if(!_SL_setChars(list, tmpNode, newValue, newLength)) return false;
     }
     tmpNode = tmpNode->next;
   }
@@ -2864,13 +6622,12 @@ bool SL_replaceArray(SL *list, String oldValue, String newValue) {
 }
 
 bool SL_replaceList(SL *list, String oldValue, CL *newValue) {
+  list->isSorted = false;
+  int oldLength = strlen(oldValue);
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(CL_equalsArray(tmpNode->value, oldValue)) {
-      CL *newCL = CL_copy(newValue);
-      if(newCL == NULL) return false;
-      CL_delete(tmpNode->value);
-      tmpNode->value = newCL;
+    if(SN_equalsArray(tmpNode, oldValue, oldLength)) {
+      if(!_SL_setList(list, tmpNode, newValue)) return false;
     }
     tmpNode = tmpNode->next;
   }
@@ -2881,7 +6638,10 @@ void SL_print(SL *list) {
   SN *tmpNode = list->start;
   printf("{");
   for(int i = 0;i < list->size;i++) {
-    CL_print(tmpNode->value);
+    String chars = SN_chars(tmpNode);
+    if(chars != NULL) {
+      fwrite(chars, 1, tmpNode->length, stdout);
+    }
     if(i != list->size - 1) {
       printf(", ");
     }
@@ -2891,41 +6651,70 @@ void SL_print(SL *list) {
 }
 
 void SL_forEach(SL *list, void (*cb)(SL *, SN *, int)) {
+  list->isSorted = false;
+  _SL_hashInvalidate(list);
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
+    if(SN_toList(tmpNode) == NULL) {
+      return;
+    }
     cb(list, tmpNode, i);
+    SN_chars(tmpNode);
     tmpNode = tmpNode->next;
   }
 }
 
+void SL_forEachReverse(SL *list, void (*cb)(SL *, SN *, int)) {
+  list->isSorted = false;
+  _SL_hashInvalidate(list);
+  for(int i = list->size - 1;i >= 0;i--) {
+    SN *tmpNode = SL_getNode(list, i);
+    if(SN_toList(tmpNode) == NULL) {
+      return;
+    }
+    cb(list, tmpNode, i);
+    SN_chars(tmpNode);
+  }
+}
+
 SL * SL_map(SL *list, CL * (*cb)(SL *, SN *, int)) {
+  list->isSorted = false;
+  _SL_hashInvalidate(list);
   SL *newSL = SL_create();
   if(newSL == NULL) {
     return NULL;
-  }  
+  }
+  newSL->intern = list->intern;  
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(!SL_addList(newSL, cb(list, tmpNode, i))) {
+    if(SN_toList(tmpNode) == NULL || !SL_addList(newSL, cb(list, tmpNode, i))) {
+      SN_chars(tmpNode);
       SL_delete(newSL);
       return NULL;
     }
+    SN_chars(tmpNode);
     tmpNode = tmpNode->next;
   }
   return newSL;
 }
 
 SL * SL_filter(SL *list, bool (*cb)(SL *, SN *, int)) {
+  list->isSorted = false;
+  _SL_hashInvalidate(list);
   SL *newSL = SL_create();
   if(newSL == NULL) {
     return NULL;
   }
+  newSL->intern = list->intern;
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(!cb(list, tmpNode, i)) {
-      tmpNode = tmpNode->next;
-      continue;
+    if(SN_toList(tmpNode) == NULL) {
+      SL_delete(newSL);
+      return NULL;
     }
-    if(!SL_addList(newSL, tmpNode->value)) {
+    bool isKept = cb(list, tmpNode, i);
+    String chars = SN_chars(tmpNode);
+    if(chars == NULL || (isKept && !_SL_addChars(newSL, chars, tmpNode->length))) {
       SL_delete(newSL);
       return NULL;
     }
@@ -2935,123 +6724,260 @@ SL * SL_filter(SL *list, bool (*cb)(SL *, SN *, int)) {
 }
 
 bool SL_every(SL *list, bool (*cb)(SL *, SN *, int)) {
+  list->isSorted = false;
+  _SL_hashInvalidate(list);
   SN *tmpNode = list->start;
   for(int i = 0;i < list->size;i++) {
-    if(!cb(list, tmpNode, i)) {
+    if(SN_toList(tmpNode) == NULL) {
+      return false;
+    }
+    bool isTrue = cb(list, tmpNode, i);
+    SN_chars(tmpNode);
+    if(!isTrue) {
+      return false;
+    }
+    tmpNode = tmpNode->next;
+  }
+  return true;
+}
+static STF_Hash * _SL_toHash(SL *list) {
+  STF_Hash *hash = STF_Hash_create(NULL, false);
+  if(hash == NULL) {
+    return NULL;
+  }
+  SN *tmpNode = list->start;
+  for(int i = 0;i < list->size;i++) {
+    String chars = SN_chars(tmpNode);
+    if(chars == NULL || STF_Hash_add(hash, chars, tmpNode->length) == NULL) {
+      STF_Hash_delete(hash);
+      return NULL;
+    }
+    tmpNode = tmpNode->next;
+  }
+  return hash;
+}
+
+static bool _SL_addDistinct(SL *list, SL *source, STF_Hash *seen, STF_Hash *filter, bool isKept) {
+  SN *tmpNode = source->start;
+  for(int i = 0;i < source->size;i++) {
+    String chars = SN_chars(tmpNode);
+    if(chars == NULL) {
       return false;
     }
+    if(filter == NULL || (STF_Hash_count(filter, chars, tmpNode->length) > 0) == isKept) {
+      STF_HashEntry *entry = STF_Hash_add(seen, chars, tmpNode->length);
+      if(entry == NULL || (entry->count == 1 && !_SL_addChars(list, chars, tmpNode->length))) {
+        return false;
+      }
+    }
     tmpNode = tmpNode->next;
   }
   return true;
 }
 
-static SL * CL_splitc(CL *charList, char sep) {
-  SL *stringList = SL_create();
-  CL *tmpCL = CL_create();
-  if(stringList == NULL) {
+static SL * _SL_combine(SL *listA, SL *listB, bool isUnion, bool isKept) {
+  SL *list = SL_createPooled();
+  if(list != NULL) {
+    list->intern = listA->intern;
+  }
+  STF_Hash *seen = STF_Hash_create(NULL, false);
+  // listB's own table is used when it has one
+  bool isShared = listB != NULL && !isUnion && _SL_hashReady(listB);
+  STF_Hash *filter = listB == NULL || isUnion ? NULL : isShared ? listB->hash : _SL_toHash(listB);
+  bool isDone = list != NULL && seen != NULL && (filter != NULL || listB == NULL || isUnion) &&
+    _SL_addDistinct(list, listA, seen, filter, isKept) &&
+    (!isUnion || _SL_addDistinct(list, listB, seen, NULL, true));
+  STF_Hash_delete(seen);
+  if(!isShared) {
+    STF_Hash_delete(filter);
+  }
+  if(!isDone && list != NULL) {
+    SL_delete(list);
     return NULL;
-  }else if(tmpCL == NULL) {
-    SL_delete(stringList);
+  }
+  return list;
+}
+
+SL * SL_unique(SL *list) {
+  return _SL_combine(list, NULL, false, true);
+}
+
+SL * SL_intersect(SL *listA, SL *listB) {
+  return _SL_combine(listA, listB, false, true);
+}
+
+SL * SL_union(SL *listA, SL *listB) {
+  return _SL_combine(listA, listB, true, true);
+}
+
+SL * SL_difference(SL *listA, SL *listB) {
+  return _SL_combine(listA, listB, false, false);
+}
+
+SL_Iter SL_iterBegin(SL *list) {
+  SL_Iter iter = {list, NULL, -1};
+  return iter;
+}
+
+bool SL_iterNext(SL_Iter *iter) {
+  if(iter->index == -1) {
+    iter->node = iter->list->start;
+  }else if(iter->node != NULL) {
+    iter->node = iter->node->next;
+  }else {
+    return false;
+  }
+  iter->index++;
+  return iter->node != NULL;
+}
+
+String SL_iterValue(SL_Iter *iter) {
+  return iter->node == NULL ? NULL : SN_chars(iter->node);
+}
+
+bool SL_iterSetArray(SL_Iter *iter, String array) {
+  iter->list->isSorted = false;
+  return iter->node != NULL && _SL_setChars(iter->list, iter->node, array, strlen(array));
+}
+
+bool SL_iterSetList(SL_Iter *iter, CL *v) {
+  iter->list->isSorted = false;
+  return iter->node != NULL && _SL_setList(iter->list, iter->node, v);
+}
+
+bool SL_iterInsertAfterArray(SL_Iter *iter, String array) {
+  if(iter->node == NULL && iter->index != -1) {
+    return false;
+  }
+  SN *stringNode = SN_create(iter->list->pool, array, iter->list->intern);
+  if(stringNode == NULL) {
+    return false;
+  }
+  if(iter->node == NULL) {
+    stringNode->next = iter->list->start;
+    iter->list->start = stringNode;
+  }else {
+    stringNode->next = iter->node->next;
+    iter->node->next = stringNode;
+  }
+  if(stringNode->next == NULL) {
+    iter->list->end = stringNode;
+  }
+  iter->list->isSorted = false;
+  _SL_indexInsert(iter->list, stringNode, iter->index + 1);
+  _SL_hashAdd(iter->list, stringNode);
+  iter->list->size++;
+  return true;
+}
+
+bool SL_iterInsertAfterList(SL_Iter *iter, CL *v) {
+  if(iter->node == NULL && iter->index != -1) {
+    return false;
+  }
+  SN *stringNode = SN_createFromList(iter->list->pool, v, iter->list->intern);
+  if(stringNode == NULL) {
+    return false;
+  }
+  if(iter->node == NULL) {
+    stringNode->next = iter->list->start;
+    iter->list->start = stringNode;
+  }else {
+    stringNode->next = iter->node->next;
+    iter->node->next = stringNode;
+  }
+  if(stringNode->next == NULL) {
+    iter->list->end = stringNode;
+  }
+  iter->list->isSorted = false;
+  _SL_indexInsert(iter->list, stringNode, iter->index + 1);
+  _SL_hashAdd(iter->list, stringNode);
+  iter->list->size++;
+  return true;
+}
+
+bool SL_iterRemoveNext(SL_Iter *iter) {
+  SN *tmpNode = iter->node == NULL ? iter->list->start : iter->node->next;
+  if(tmpNode == NULL || (iter->node == NULL && iter->index != -1)) {
+    return false;
+  }
+  if(iter->node == NULL) {
+    iter->list->start = tmpNode->next;
+  }else {
+    iter->node->next = tmpNode->next;
+  }
+  if(tmpNode == iter->list->end) {
+    iter->list->end = iter->node;
+  }
+  _SL_indexRemove(iter->list, iter->index + 1);
+  iter->list->size--;
+  _SL_hashRemove(iter->list, tmpNode);
+  SN_delete(iter->list->pool, tmpNode);
+  return true;
+}
+
+
+static String _CL_search(String chars, int length, String sep, int sepLength) {
+  String end = chars + length - sepLength + 1;
+  while(chars < end) {
+    chars = (String)memchr(chars, sep[0], end - chars);
+    if(chars == NULL || memcmp(chars, sep, sepLength) == 0) {
+      return chars;
+    }
+    chars++;
+  }
+  return NULL;
+}
+
+static SL * _CL_splitChars(String chars, int length, String sep, int sepLength) {
+  SL *stringList = SL_createPooled();
+  if(stringList == NULL) {
     return NULL;
   }
-  CN *tmpNode = charList->start;
-  for(int i = 0;i < charList->size;i++) {
-    if(tmpNode->value == sep) {
-      if(!SL_addList(stringList, tmpCL)) {
-        CL_delete(tmpCL);
-        SL_delete(stringList);
-        return NULL;
-      }
-      CL_clear(tmpCL);
-    }else {
-      if(!CL_add(tmpCL, tmpNode->value)) {
-        CL_delete(tmpCL);
+  String field = chars, end = chars + length;
+  if(sepLength > 0) {
+    for(String match;(match = _CL_search(field, end - field, sep, sepLength)) != NULL;field = match + sepLength) {
+      if(!_SL_addChars(stringList, field, match - field)) {
         SL_delete(stringList);
         return NULL;
       }
     }
-    tmpNode = tmpNode->next;
   }
-  if(!SL_addList(stringList, tmpCL)) {
-    CL_delete(tmpCL);
+  if(!_SL_addChars(stringList, field, end - field)) {
     SL_delete(stringList);
     return NULL;
   }
-  CL_delete(tmpCL);
   return stringList;
 }
 
-static String _CL_substr(CL *charList, int start, int length) {
-  CL *subList = CL_sub(charList, start, length);
-  if(subList == NULL) {
+static SL * CL_splitc(CL *charList, char sep) {
+  String chars = CL_toCharArray(charList);
+  if(chars == NULL) {
     return NULL;
   }
-  String str = CL_toCharArray(subList);
-  CL_delete(subList);
-  return str;
+  SL *stringList = _CL_splitChars(chars, charList->size, &sep, 1);
+  STF_free(chars);
+  return stringList;
 }
 
 SL * CL_split(CL *charList, String sep) {
-  if(strlen(sep) == 1) {
+  int sepLength = strlen(sep);
+  if(sepLength == 1) {
     return CL_splitc(charList, sep[0]);
-  }
-  SL *stringList = SL_create();
-  if(stringList == NULL) {
-    return NULL;
-  }
-  if(CL_equalsArray(charList, sep)) {
-    if(!SL_addArray(stringList, "") || !SL_addArray(stringList, "")) {
-      SL_delete(stringList);
+  }else if(sepLength == 0 && charList->size == 0) {
+    SL *stringList = SL_createPooled();
+    if(stringList == NULL) {
       return NULL;
-    }
-    return stringList;
-  }
-  CL *tmpCL = CL_create();
-  CN *tmpNode = charList->start;
-  for(int i = 0;i < charList->size;i++) {
-    if(tmpNode->value != sep[0]) {
-      if(!CL_add(tmpCL, tmpNode->value)) {
-        SL_delete(stringList);
-        CL_delete(tmpCL);
-        return NULL;
-      }
-      tmpNode = tmpNode->next;
-      continue;
-    }
-    String s = _CL_substr(charList, i, strlen(sep));
-    if(s == NULL) {
+    }else if(!SL_addArray(stringList, "") || !SL_addArray(stringList, "")) {
       SL_delete(stringList);
-      CL_delete(tmpCL);
       return NULL;
     }
-    if(!strcmp(s, sep)) {
-      if(!SL_addList(stringList, tmpCL)) {
-        SL_delete(stringList);
-        CL_delete(tmpCL);
-        free(s);
-        return NULL;
-      }
-      CL_clear(tmpCL);
-      i += strlen(sep) - 1;
-      for(int j = 0;j < strlen(sep) - 1; j++) {
-        tmpNode = tmpNode->next;
-      }
-    }else {
-      if(!CL_add(tmpCL, tmpNode->value)) {
-        SL_delete(stringList);
-        CL_delete(tmpCL);
-        free(s);
-        return NULL;
-      }
-    }
-    free(s);
-    tmpNode = tmpNode->next;
+    return stringList;
   }
-  if(!SL_addList(stringList, tmpCL)) {
-    SL_delete(stringList);
-    CL_delete(tmpCL);
+  String chars = CL_toCharArray(charList);
+  if(chars == NULL) {
     return NULL;
   }
-  CL_delete(tmpCL);
+  SL *stringList = _CL_splitChars(chars, charList->size, sep, sepLength);
+  STF_free(chars);
   return stringList;
 }
\ No newline at end of file
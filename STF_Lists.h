@@ -34,6 +34,7 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include <limits.h>
 
 typedef char * String;
 
@@ -61,103 +62,1286 @@ typedef struct DN {
   struct DN *next;
 } DN;
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief allocator class, the functions the library calls to get and give
+/// back memory, context is passed to each of them untouched
+///
+////////////////////////////////////////////////////////////////////////////////
+typedef struct {
+  void * (*alloc)(void *context, size_t size);
+  void * (*realloc)(void *context, void *memory, size_t size);
+  void (*free)(void *context, void *memory);
+  void *context;
+} STF_Allocator;
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief record of a list made in an arena, type is 'B', 'C', 'I', 'D' or 'S'
+///
+////////////////////////////////////////////////////////////////////////////////
+typedef struct STF_ArenaList {
+  void *list;
+  char type;
+  struct STF_ArenaList *next;
+} STF_ArenaList;
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief arena class, a bump allocator which cuts memory out of large blocks
+/// and gives it all back at once, the newest block (blockSize bytes) is kept
+/// on reset, lists holds the lists made in the arena so reset can release
+/// what they hold outside of it
+///
+////////////////////////////////////////////////////////////////////////////////
+typedef struct {
+  char *blocks;
+  char *cursor;
+  size_t available;
+  size_t blockSize;
+  STF_ArenaList *lists;
+} STF_Arena;
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief node pool class which carves fixed size nodes out of large chunks,
+/// the chunks come from arena when it's not NULL, otherwise from allocator or
+/// the global allocator when that's NULL too
+///
+////////////////////////////////////////////////////////////////////////////////
+typedef struct {
+  STF_Arena *arena;
+  const STF_Allocator *allocator;
+  void *chunks;
+  void *freeNodes;
+  char *cursor;
+  int available;
+  int nodeSize;
+  int chunkLength;
+} STF_Pool;
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief hash table entry, one per distinct string with the number of times
+/// it's in the list, chars is the key and NULL marks an empty slot
+///
+////////////////////////////////////////////////////////////////////////////////
+typedef struct {
+  String chars;
+  int length;
+  unsigned code;
+  int count;
+} STF_HashEntry;
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief open addressing hash table counting strings, isStale is set when
+/// the list changed in a way the table couldn't follow, it's rebuilt lazily,
+/// ownsKeys tells if the keys are copies made by the table, each preceded by
+/// the address of the table, or the chars of one of the counted nodes, the
+/// table and its keys come from allocator (the global one when NULL)
+///
+////////////////////////////////////////////////////////////////////////////////
+typedef struct {
+  const STF_Allocator *allocator;
+  STF_HashEntry *entries;
+  int capacity;
+  int size;
+  bool ownsKeys;
+  bool isStale;
+} STF_Hash;
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief intern pool, a table owning one read-only copy of every string its
+/// lists hold, made by the caller and passed to SL_enableInterning
+///
+////////////////////////////////////////////////////////////////////////////////
+typedef STF_Hash STF_Intern;
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief open addressing set of ints with a fixed number of slots
+///
+////////////////////////////////////////////////////////////////////////////////
+typedef struct {
+  int *values;
+  bool *isUsed;
+  int capacity;
+} STF_IntSet;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief node list class with the first and last nodes and the size of the list
 ///
+/// The list also keeps a table of its node addresses (nodes, capacity) which is
+/// filled the first time a node is reached by index and kept in sync by the
+/// functions that add or remove nodes, isIndexed tells if the table is usable,
+/// the table starts at offset so removing the first node doesn't move it,
+/// isView marks a list returned by XL_view that only borrows its nodes,
+/// isPacked (only in BL) marks a list that keeps its values as bits in the
+/// words of bits (bitCapacity of them) instead of nodes,
+/// isSorted (not in BL) tells if the list is known to be in ascending order,
+/// intern (only in SL) is the intern pool the strings of the list share their
+/// chars through, NULL when they each have their own
+///
 ////////////////////////////////////////////////////////////////////////////////
 typedef struct {
   CN *start;
   CN *end;
   int size;
+  STF_Pool *pool;
+  CN **nodes;
+  int capacity;
+  int offset;
+  bool isIndexed;
+  bool isView;
+  bool isSorted;
 } CL;
 
+// strings shorter than this are kept inside their node instead of on the heap,
+// it's the size of the buffer that shares its place with the heap pointer, 23
+// chars and the NUL fit so most keys, codes and words never allocate
+#define STF_SHORT_LENGTH 24
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief A string node keeps its characters in one flat, NUL terminated
+/// buffer, isShort tells that they sit in storage.shortChars (strings shorter
+/// than STF_SHORT_LENGTH), otherwise storage.chars points to a heap buffer or
+/// to an intern pool, value is only set to a charList copy of them while a
+/// callback (forEach, map, filter, every) is looking at the node, isInterned
+/// marks chars that belong to an intern pool and must never be written to, the
+/// pool is found from the chars so they're kept while value is set
+///
+////////////////////////////////////////////////////////////////////////////////
 typedef struct SN {
   CL *value;
   struct SN *next;
+  union {
+    String chars;
+    char shortChars[STF_SHORT_LENGTH];
+  } storage;
+  int length;
+  bool isInterned;
+  bool isShort;
 } SN;
 
 typedef struct {
   BN *start;
   BN *end;
   int size;
+  STF_Pool *pool;
+  BN **nodes;
+  int capacity;
+  int offset;
+  unsigned long long *bits;
+  int bitCapacity;
+  bool isIndexed;
+  bool isView;
+  bool isPacked;
 } BL;
 
 typedef struct {
   IN *start;
   IN *end;
   int size;
+  STF_Pool *pool;
+  IN **nodes;
+  int capacity;
+  int offset;
+  bool isIndexed;
+  bool isView;
+  bool isSorted;
 } IL;
 
 typedef struct {
   DN *start;
   DN *end;
   int size;
+  STF_Pool *pool;
+  DN **nodes;
+  int capacity;
+  int offset;
+  bool isIndexed;
+  bool isView;
+  bool isSorted;
 } DL;
 
 typedef struct {
   SN *start;
   SN *end;
   int size;
+  STF_Pool *pool;
+  SN **nodes;
+  int capacity;
+  int offset;
+  bool isIndexed;
+  bool isView;
+  bool isSorted;
+  STF_Hash *hash;
+  STF_Intern *intern;
 } SL;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief Delete a string node
+/// \brief An iterator over a list, it starts before the first node so that
+/// insertAfter and removeNext can also work on the head of the list
+///
+/// \param list  The list being walked
+/// \param node  The current node, NULL before the first and after the last,
+///              and always NULL while a BL is packed
+/// \param index The index of the current node, -1 before the first
+///
+////////////////////////////////////////////////////////////////////////////////
+typedef struct {
+  BL *list;
+  BN *node;
+  int index;
+} BL_Iter;
+
+typedef struct {
+  CL *list;
+  CN *node;
+  int index;
+} CL_Iter;
+
+typedef struct {
+  IL *list;
+  IN *node;
+  int index;
+} IL_Iter;
+
+typedef struct {
+  DL *list;
+  DN *node;
+  int index;
+} DL_Iter;
+
+typedef struct {
+  SL *list;
+  SN *node;
+  int index;
+} SL_Iter;
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief sort key class with a string node and its chars flattened for sorting
 ///
-/// \param stringNode The node to delete
+////////////////////////////////////////////////////////////////////////////////
+typedef struct {
+  String chars;
+  int length;
+  SN *node;
+} SK;
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The default allocator functions, they call malloc, realloc and free
 ///
 ////////////////////////////////////////////////////////////////////////////////
-static void SN_delete(SN *stringNode);
+static void * _STF_stdAlloc(void *context, size_t size);
+static void * _STF_stdRealloc(void *context, void *memory, size_t size);
+static void _STF_stdFree(void *context, void *memory);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief Create a new stringNode object from a charList
+/// \brief Get, zero or resize memory from the global allocator
 ///
-/// \param charList The charlist to create from
+/// \param memory The memory to resize
+/// \param count  The number of items
+/// \param size   The size in bytes (of each item for STF_calloc)
 ///
-/// \return A new CharNode object, or NULL if it failed
+/// \return The memory, or NULL if it failed
 ///
 ////////////////////////////////////////////////////////////////////////////////
-static SN * SN_createFromList(CL *charList);
+static void * STF_malloc(size_t size);
+static void * STF_calloc(size_t count, size_t size);
+static void * STF_realloc(void *memory, size_t size);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief Create a new node object
+/// \brief Give back memory the library kept for itself to the global allocator
 ///
-/// \param v The value of the node
+/// \param memory The memory to give back, can be NULL
 ///
-/// \return A new node object, or NULL if it failed
+////////////////////////////////////////////////////////////////////////////////
+static void STF_release(void *memory);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get memory from the global allocator for an array or a string handed
+/// to the caller, it isn't counted as in use by the library
+///
+/// \param size The number of bytes
+///
+/// \return The memory, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static void * STF_mallocOut(size_t size);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get, zero, resize or give back memory from a given allocator
+///
+/// \param allocator The allocator, or NULL for the global one
+/// \param memory    The memory to resize or give back, can be NULL
+/// \param count     The number of items
+/// \param size      The size in bytes (of each item for STF_callocWith)
+///
+/// \return The memory, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static void * STF_allocWith(const STF_Allocator *allocator, size_t size);
+static void * STF_callocWith(const STF_Allocator *allocator, size_t count, size_t size);
+static void * STF_reallocWith(const STF_Allocator *allocator, void *memory, size_t size);
+static void STF_freeWith(const STF_Allocator *allocator, void *memory);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Cut memory out of the arena, adding a block when the current one
+/// is too small
+///
+/// \param arena The arena to allocate from
+/// \param size  The number of bytes, rounded up so every cut stays aligned
+///
+/// \return The memory, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static void * STF_Arena_alloc(STF_Arena *arena, size_t size);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Record a list made in the arena so reset releases it
+///
+/// \param arena The arena the list was made in
+/// \param list  The list
+/// \param type  'B', 'C', 'I', 'D' or 'S'
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool _STF_Arena_track(STF_Arena *arena, void *list, char type);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new node pool object
+///
+/// \param nodeSize The size of each node handed out by the pool
+///
+/// \return A new pool object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static STF_Pool * STF_Pool_create(int nodeSize);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new node pool object whose chunks come from an arena or
+/// an allocator
+///
+/// \param arena     The arena to take the pool and its chunks from, or NULL
+/// \param allocator The allocator to use when arena is NULL, NULL for the global one
+/// \param nodeSize The size of each node handed out by the pool
+///
+/// \return A new pool object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static STF_Pool * STF_Pool_createIn(STF_Arena *arena, const STF_Allocator *allocator, int nodeSize);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new node pool object that takes its memory from the same
+/// place as another pool
+///
+/// \param pool     The pool to copy the arena and allocator of, or NULL
+/// \param nodeSize The size of each node handed out by the pool
+///
+/// \return A new pool object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static STF_Pool * STF_Pool_createLike(STF_Pool *pool, int nodeSize);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get the allocator the memory of a list comes from
+///
+/// \param pool The pool of the list, or NULL
+///
+/// \return The allocator of the pool, or NULL for the global one
+///
+////////////////////////////////////////////////////////////////////////////////
+static const STF_Allocator * STF_Pool_allocator(STF_Pool *pool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Add a new chunk of nodes to the pool and make it the current one
+///
+/// \param pool   The pool to grow
+/// \param length The number of nodes in the chunk
+///
+/// \return true if it's successful, false otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool STF_Pool_grow(STF_Pool *pool, int length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get a node from the pool, growing it by a new chunk when it's empty,
+/// each of those chunks is twice as long as the one before
+///
+/// \param pool The pool to allocate from
+///
+/// \return The address of the node, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static void * STF_Pool_alloc(STF_Pool *pool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Make sure the next count nodes can be cut from a single chunk, a
+/// new chunk holds exactly count nodes
+///
+/// \param pool  The pool to reserve in
+/// \param count The number of nodes about to be allocated
+///
+/// \return true if it's successful, false otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool STF_Pool_reserve(STF_Pool *pool, int count);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Give a node back to the pool so it can be reused
+///
+/// \param pool The pool the node came from
+/// \param node The node to release
+///
+////////////////////////////////////////////////////////////////////////////////
+static void STF_Pool_free(STF_Pool *pool, void *node);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Hand all the chunks and free nodes of a pool over to another pool,
+/// the other pool is left empty but can still be used or deleted
+///
+/// \param pool  The pool to take the memory
+/// \param other The pool to give it away
+///
+////////////////////////////////////////////////////////////////////////////////
+static void STF_Pool_merge(STF_Pool *pool, STF_Pool *other);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Release all the chunks of a pool at once, every node cut from it
+/// is gone and the pool starts over empty
+///
+/// \param pool The pool to reset
+///
+////////////////////////////////////////////////////////////////////////////////
+static void STF_Pool_reset(STF_Pool *pool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Delete the pool and release all of its chunks at once
+///
+/// \param pool The pool to delete
+///
+////////////////////////////////////////////////////////////////////////////////
+static void STF_Pool_delete(STF_Pool *pool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Hash length chars with FNV-1a
+///
+/// \param chars  The chars to hash
+/// \param length The number of chars
+///
+/// \return The hash code
+///
+////////////////////////////////////////////////////////////////////////////////
+static unsigned STF_hash(String chars, int length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new empty hash table
+///
+/// \param allocator The allocator of the table, or NULL for the global one
+/// \param ownsKeys  true to copy the keys, false to borrow the chars given to
+///                 STF_Hash_add, they must then live as long as their entry
+///
+/// \return The new table, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static STF_Hash * STF_Hash_create(const STF_Allocator *allocator, bool ownsKeys);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Find the entry of a string, or the empty slot where it would go
+///
+/// \param hash   The table to search in
+/// \param chars  The chars of the string
+/// \param length The number of chars
+/// \param code   The hash code of the string
+///
+/// \return The address of the entry
+///
+////////////////////////////////////////////////////////////////////////////////
+static STF_HashEntry * STF_Hash_find(STF_Hash *hash, String chars, int length, unsigned code);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Double the number of slots of the table and put the entries back
+///
+/// \param hash The table to grow
+///
+/// \return true if it's successful, false otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool _STF_Hash_grow(STF_Hash *hash);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Count one more occurrence of a string
+///
+/// \param hash   The table to add to
+/// \param chars  The chars of the string
+/// \param length The number of chars
+///
+/// \return The entry of the string, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static STF_HashEntry * STF_Hash_add(STF_Hash *hash, String chars, int length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Count one less occurrence of a string, dropping it at zero
+///
+/// \param hash   The table to remove from
+/// \param chars  The chars of the string
+/// \param length The number of chars
+///
+////////////////////////////////////////////////////////////////////////////////
+static void STF_Hash_remove(STF_Hash *hash, String chars, int length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Count one less occurrence of the string of an entry got from
+/// STF_Hash_find, dropping it at zero
+///
+/// \param hash  The table of the entry
+/// \param entry The entry, it must hold a string
+///
+////////////////////////////////////////////////////////////////////////////////
+static void STF_Hash_removeEntry(STF_Hash *hash, STF_HashEntry *entry);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get the number of occurrences of a string
+///
+/// \param hash   The table to search in
+/// \param chars  The chars of the string
+/// \param length The number of chars
+///
+/// \return The count, 0 if the string isn't in the table
+///
+////////////////////////////////////////////////////////////////////////////////
+static int STF_Hash_count(STF_Hash *hash, String chars, int length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Remove every entry of the table, keeping its slots
+///
+/// \param hash The table to clear
+///
+////////////////////////////////////////////////////////////////////////////////
+static void STF_Hash_clear(STF_Hash *hash);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Delete the table and the keys it owns
+///
+/// \param hash The table to delete, can be NULL
+///
+////////////////////////////////////////////////////////////////////////////////
+static void STF_Hash_delete(STF_Hash *hash);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get the shared copy of a string from an intern pool, one buffer is
+/// kept per distinct string for as long as some node points to it, the count
+/// of its entry being the number of those nodes
+///
+/// \param intern The pool to share through
+/// \param chars  The chars of the string
+/// \param length The number of chars
+///
+/// \return The shared chars, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static String STF_intern(STF_Intern *intern, String chars, int length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Give back a string got from STF_intern to the pool it came from
+///
+/// \param chars  The shared chars
+/// \param length The number of chars
+///
+////////////////////////////////////////////////////////////////////////////////
+static void STF_unintern(String chars, int length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Look a string up in an intern pool without adding it
+///
+/// \param intern The pool to search in, can be NULL
+/// \param chars  The chars of the string
+/// \param length The number of chars
+///
+/// \return The shared chars, or NULL if no node holds the string interned
+///
+////////////////////////////////////////////////////////////////////////////////
+static String STF_internFind(STF_Intern *intern, String chars, int length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get the table that owns a key it copied
+///
+/// \param key A key of a table created with ownsKeys
+///
+/// \return The table
+///
+////////////////////////////////////////////////////////////////////////////////
+static STF_Hash * STF_Hash_ownerOf(String key);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new empty set of ints
+///
+/// \param expected The most values that will be added to the set
+///
+/// \return The new set, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static STF_IntSet * STF_IntSet_create(int expected);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Find the slot of a value, or the empty slot where it would go
+///
+/// \param set The set to search in
+/// \param v   The value to find
+///
+/// \return The index of the slot
+///
+////////////////////////////////////////////////////////////////////////////////
+static int _STF_IntSet_find(STF_IntSet *set, int v);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Add a value to the set
+///
+/// \param set The set to add to
+/// \param v   The value to add
+///
+/// \return true if the value is new, false if it was already in the set
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool STF_IntSet_add(STF_IntSet *set, int v);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Check if the set has a value
+///
+/// \param set The set to search in
+/// \param v   The value to check
+///
+/// \return true if it's in the set and false otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool STF_IntSet_contains(STF_IntSet *set, int v);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Delete the set
+///
+/// \param set The set to delete, can be NULL
+///
+////////////////////////////////////////////////////////////////////////////////
+static void STF_IntSet_delete(STF_IntSet *set);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Fill a 256 entry table mapping each byte to its lowercase or uppercase
+///
+/// The table follows tolower/toupper for the current locale, the case
+/// functions build it once per call and then convert with a plain lookup
+/// instead of a library call per char
+///
+/// \param table   The table to fill, at least 256 bytes
+/// \param isUpper true to map to uppercase, false to map to lowercase
+///
+////////////////////////////////////////////////////////////////////////////////
+static void STF_caseTable(unsigned char *table, bool isUpper);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Count the set bits of a word
+///
+/// \param word The word to count in
+///
+/// \return The number of bits set to 1
+///
+////////////////////////////////////////////////////////////////////////////////
+static int STF_popcount(unsigned long long word);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Make sure a packed list has words for a given number of bits
+///
+/// \param list The packed list
+/// \param size The number of bits it must hold
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool _BL_packedReserve(BL *list, int size);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Clear the bits past the end of a packed list in its last word
+///
+/// Every function on packed lists counts on those bits being 0
+///
+/// \param list The packed list
+///
+////////////////////////////////////////////////////////////////////////////////
+static void _BL_maskTail(BL *list);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Combine two lists of the same size value by value into the first one
+///
+/// \param listA The list to change
+/// \param listB The list to combine with
+/// \param op    '&', '|' or '^'
+///
+/// \return false if the sizes differ and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool _BL_combineBits(BL *listA, BL *listB, char op);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Unpack the list of an iterator before it relinks nodes, and point
+/// the iterator at the node of its index
+///
+/// \param iter The iterator
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool _BL_iterUnpack(BL_Iter *iter);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Delete a node, giving it back to the pool if there's one
+///
+/// \param pool The pool of the node's list, or NULL
+/// \param node The node to delete
+///
+////////////////////////////////////////////////////////////////////////////////
+static void BN_delete(STF_Pool *pool, BN *node);
+static void CN_delete(STF_Pool *pool, CN *node);
+static void IN_delete(STF_Pool *pool, IN *node);
+static void DN_delete(STF_Pool *pool, DN *node);
+static void SN_delete(STF_Pool *pool, SN *node);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new stringNode object from a charList
+///
+/// \param pool       The pool of the node's list, or NULL
+/// \param charList   The charlist to create from
+/// \param intern     The intern pool to keep the chars in, or NULL
+///
+/// \return A new CharNode object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static SN * SN_createFromList(STF_Pool *pool, CL *charList, STF_Intern *intern);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new node object
+///
+/// \param pool       The pool of the node's list, or NULL to use malloc
+/// \param v          The value of the node
+/// \param intern     The intern pool to keep the chars in, or NULL (SN_create)
+///
+/// \return A new node object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static BN * BN_create(STF_Pool *pool, bool v);
+static CN * CN_create(STF_Pool *pool, char v);
+static IN * IN_create(STF_Pool *pool, int v);
+static DN * DN_create(STF_Pool *pool, double v);
+static SN * SN_create(STF_Pool *pool, String v, STF_Intern *intern);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new stringNode object from the first length chars of an array
+///
+/// \param pool       The pool of the node's list, or NULL
+/// \param chars      The chars to copy
+/// \param length     The number of chars to copy
+/// \param intern     The intern pool to keep the chars in, or NULL
+///
+/// \return A new stringNode object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static SN * SN_createFrom(STF_Pool *pool, String chars, int length, STF_Intern *intern);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Replace the chars of a stringNode, the node is untouched on failure,
+/// an interned node gets the shared copy of the new chars
+///
+/// \param stringNode The node to set
+/// \param chars      The chars to copy (SN_setChars)
+/// \param length     The number of chars to copy (SN_setChars)
+/// \param charList   The charList to copy (SN_setList)
+/// \param intern     The intern pool to keep the new chars in, or NULL
+///
+/// \return true if it's successful, false otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool SN_setChars(SN *stringNode, String chars, int length, STF_Intern *intern);
+static bool SN_setList(SN *stringNode, CL *charList, STF_Intern *intern);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Release the chars of a string node unless they're kept inside it,
+/// interned chars are given back to their intern pool
+///
+/// \param stringNode The node, its chars are NULL afterwards
+///
+////////////////////////////////////////////////////////////////////////////////
+static void _SN_freeChars(SN *stringNode);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get where the chars of a string node are kept, inside it or not,
+/// without folding back its charList
+///
+/// \param stringNode The node to get from
+///
+/// \return The chars of the node, or NULL if it has none
+///
+////////////////////////////////////////////////////////////////////////////////
+static String _SN_buffer(SN *stringNode);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Move the chars of a stringNode into, out of or between intern pools,
+/// a node has to leave its pool before its chars are changed in place
+///
+/// \param stringNode The node to move
+/// \param intern     The pool to share the chars through, NULL to give the
+///                   node its own
+///
+/// \return true if it's successful, false otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool SN_setInterned(SN *stringNode, STF_Intern *intern);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get the intern pool the chars of a stringNode belong to
+///
+/// \param stringNode The node to check
+///
+/// \return The pool, or NULL if the node isn't interned
+///
+////////////////////////////////////////////////////////////////////////////////
+static STF_Intern * _SN_intern(SN *stringNode);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Turn the chars of a stringNode into a charList for a callback
+///
+/// \param stringNode The node to expand
+///
+/// \return The charList now held in stringNode->value, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static CL * SN_toList(SN *stringNode);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get the flat chars of a stringNode, folding back its charList if a
+/// callback expanded it
+///
+/// \param stringNode The node to get from
+///
+/// \return The chars of the node, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static String SN_chars(SN *stringNode);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Check if a stringNode holds the given string
+///
+/// \param stringNode The node to check
+/// \param array      The chars to check against (SN_equalsArray)
+/// \param length     The number of chars in array (SN_equalsArray)
+/// \param charList   The charList to check against (SN_equalsList)
+///
+/// \return true if they are equal, false otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool SN_equalsArray(SN *stringNode, String array, int length);
+static bool SN_equalsList(SN *stringNode, CL *charList);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Check if a stringNode holds the given string, a node interned in
+/// intern is only compared by address with key
+///
+/// \param stringNode The node to check
+/// \param intern     The pool key was looked up in, can be NULL
+/// \param key        The result of STF_internFind for array
+/// \param array      The chars to check against
+/// \param length     The number of chars in array
+///
+/// \return true if they are equal, false otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool SN_equalsKey(SN *stringNode, STF_Intern *intern, String key, String array, int length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Check if two stringNodes hold the same string, by address when both
+/// are interned in the same pool
+///
+/// \param stringNodeA The first node
+/// \param stringNodeB The second node
+///
+/// \return true if they are equal, false otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool SN_equals(SN *stringNodeA, SN *stringNodeB);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Compare two stringNodes the same way CL_compare does
+///
+/// \param stringNodeA The first node
+/// \param stringNodeB The second node
+///
+/// \return 1 if stringNodeA comes first, -1 if stringNodeB does, 0 if equal
+///
+////////////////////////////////////////////////////////////////////////////////
+static int SN_compare(SN *stringNodeA, SN *stringNodeB);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get the node address of the given index
+///
+/// \param list  The list to get from
+/// \param index The index of the node
+///
+/// \return The address of the node, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static BN * BL_getNode(BL *list, int index);
+static CN * CL_getNode(CL *list, int index);
+static IN * IL_getNode(IL *list, int index);
+static DN * DL_getNode(DL *list, int index);
+static SN * SL_getNode(SL *list, int index);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Make sure the node table of the list can hold a given number of nodes
+///
+/// \param list     The list to grow
+/// \param capacity The number of nodes the table must hold
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool _BL_reserve(BL *list, int capacity);
+static bool _CL_reserve(CL *list, int capacity);
+static bool _IL_reserve(IL *list, int capacity);
+static bool _DL_reserve(DL *list, int capacity);
+static bool _SL_reserve(SL *list, int capacity);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Fill the node table of the list so nodes can be reached by index in O(1)
+///
+/// \param list The list to index
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool _BL_index(BL *list);
+static bool _CL_index(CL *list);
+static bool _IL_index(IL *list);
+static bool _DL_index(DL *list);
+static bool _SL_index(SL *list);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Keep the node table in sync after a node was linked in the list
+///
+/// \param list  The list the node was linked in
+/// \param node  The new node
+/// \param index The index of the new node
+///
+////////////////////////////////////////////////////////////////////////////////
+static void _BL_indexInsert(BL *list, BN *node, int index);
+static void _CL_indexInsert(CL *list, CN *node, int index);
+static void _IL_indexInsert(IL *list, IN *node, int index);
+static void _DL_indexInsert(DL *list, DN *node, int index);
+static void _SL_indexInsert(SL *list, SN *node, int index);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Keep the node table in sync after a node was unlinked from the list
+///
+/// \param list  The list the node was unlinked from
+/// \param index The index of the removed node
+///
+////////////////////////////////////////////////////////////////////////////////
+static void _BL_indexRemove(BL *list, int index);
+static void _CL_indexRemove(CL *list, int index);
+static void _IL_indexRemove(IL *list, int index);
+static void _DL_indexRemove(DL *list, int index);
+static void _SL_indexRemove(SL *list, int index);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new list object
+///
+/// \return A new list object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+BL * BL_create(void);
+CL * CL_create(void);
+IL * IL_create(void);
+DL * DL_create(void); 
+SL * SL_create(void);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new list object whose nodes come from its own node pool
+///
+/// Nodes are carved out of large chunks instead of being allocated one by one,
+/// removed nodes are kept for reuse and every chunk is released by *_delete
+///
+/// \return A new list object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+BL * BL_createPooled(void);
+CL * CL_createPooled(void);
+IL * IL_createPooled(void);
+DL * DL_createPooled(void);
+SL * SL_createPooled(void);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new empty arena
+///
+/// \return A new arena object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+STF_Arena * STF_Arena_create(void);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Delete every list made in the arena and give back its memory at once,
+/// the newest block is kept for the next round
+///
+/// \param arena The arena to reset
+///
+////////////////////////////////////////////////////////////////////////////////
+void STF_Arena_reset(STF_Arena *arena);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Reset the arena and delete it
+///
+/// \param arena The arena to delete, can be NULL
+///
+////////////////////////////////////////////////////////////////////////////////
+void STF_Arena_delete(STF_Arena *arena);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new empty intern pool
+///
+/// A pool has no lock, like the rest of the library it must only be used by
+/// one thread at a time, so threads working apart should each have their own
+///
+/// \return A new pool, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+STF_Intern * STF_Intern_create(void);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Delete an intern pool, every list interning through it must have
+/// been deleted or had SL_disableInterning called first
+///
+/// \param intern The pool to delete, can be NULL
+///
+////////////////////////////////////////////////////////////////////////////////
+void STF_Intern_delete(STF_Intern *intern);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new list object in an arena
+///
+/// The list header and its nodes are cut out of the arena, the node table,
+/// string buffers and hash table still come from malloc and are released by
+/// *_delete or by the arena reset, *_delete doesn't give the arena memory back,
+/// only STF_Arena_reset does
+///
+/// \param arena The arena to make the list in
+///
+/// \return A new list object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+BL * BL_createIn(STF_Arena *arena);
+CL * CL_createIn(STF_Arena *arena);
+IL * IL_createIn(STF_Arena *arena);
+DL * DL_createIn(STF_Arena *arena);
+SL * SL_createIn(STF_Arena *arena);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new list object in an arena from a string
+///
+/// \param arena The arena to make the list in
+/// \param array The string to copy
+///
+/// \return A new list object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+CL * CL_createFromIn(STF_Arena *arena, String array);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Replace the allocator used by the whole library
+///
+/// Memory is always given back to the allocator it came from, so the allocator
+/// can only change while the library holds nothing from it: every list made
+/// with it must be deleted first, which is checked, the library isn't
+/// thread-safe so this must not race with other calls
+///
+/// The arrays and strings handed to the caller (*_toXArray, SL_get) aren't
+/// checked since plain free may release them under the default allocator,
+/// the caller gives them back before changing allocator
+///
+/// \param allocator The allocator to copy, or NULL to go back to malloc and free
+///
+/// \return false if memory from the current allocator is still in use (nothing
+///         changes then) and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+bool STF_setAllocator(const STF_Allocator *allocator);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Give back memory returned by the library, like the arrays of
+/// *_toXArray or the strings of SL_get, to the global allocator
+///
+/// \param memory The memory to give back, can be NULL
+///
+////////////////////////////////////////////////////////////////////////////////
+void STF_free(void *memory);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new pooled list object with its own allocator
+///
+/// Everything the list keeps comes from the allocator: its header, pool, node
+/// chunks, node table, hash table and packed bits, except the chars of the
+/// strings of an SL which stay on the global allocator since a string node
+/// doesn't know its list, the arrays and strings handed to the caller and the
+/// scratch memory of sorts and set operations come from the global allocator
+///
+/// \param allocator The allocator, it must outlive the list
+///
+/// \return A new list object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+BL * BL_createWith(const STF_Allocator *allocator);
+CL * CL_createWith(const STF_Allocator *allocator);
+IL * IL_createWith(const STF_Allocator *allocator);
+DL * DL_createWith(const STF_Allocator *allocator);
+SL * SL_createWith(const STF_Allocator *allocator);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Move the nodes of the list into one new pool chunk, in list order
+///
+/// After many inserts and removes the nodes end up scattered, compacting puts
+/// them side by side again so walking the list reads memory in order, the
+/// list is pooled afterwards, node addresses change so iterators, views and
+/// node pointers taken before are no longer valid
+///
+/// \param list The list to compact, can't be a view
+///
+/// \return false if it failed and true otherwise, the list is unchanged on failure
+///
+////////////////////////////////////////////////////////////////////////////////
+bool BL_compact(BL *list);
+bool CL_compact(CL *list);
+bool IL_compact(IL *list);
+bool DL_compact(DL *list);
+bool SL_compact(SL *list);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new packed list object that keeps its values as bits,
+/// 64 to a word, instead of one node per value
+///
+/// add, pop, get, set, fill, replace, count, indexOf, lastIndexOf, contains,
+/// sort, copy, slice, compare, the bitwise functions, the callbacks and the
+/// iterators (except insertAfter and removeNext) work on the bits directly,
+/// BL_view returns an empty view, any other function unpacks the list first
+///
+/// \return A new list object, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+BL * BL_createPacked(void);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Turn the nodes of the list into bits and release them
+///
+/// \param list The list to pack, can't be a view
+///
+/// \return false if it failed and true otherwise, the list is unchanged on failure
+///
+////////////////////////////////////////////////////////////////////////////////
+bool BL_pack(BL *list);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Turn the bits of a packed list back into nodes
+///
+/// \param list The list to unpack
+///
+/// \return false if it failed and true otherwise, the list is unchanged on failure
+///
+////////////////////////////////////////////////////////////////////////////////
+bool BL_unpack(BL *list);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Attach a hash table of the strings to the list, after this
+/// containsArray and countArray are O(1) and indexOfArray, lastIndexOfArray
+/// return -1 at once when the string is missing, the table is kept up to date
+/// when nodes are added, removed or set, and rebuilt on the next lookup after
+/// a callback or a case conversion, it doesn't copy the strings, each key is
+/// the chars of one of the nodes holding it
+///
+/// \param list The list to hash
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+bool SL_enableHash(SL *list);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Drop the hash table of the list, if there's one
+///
+/// \param list The list to unhash
+///
+////////////////////////////////////////////////////////////////////////////////
+void SL_disableHash(SL *list);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Keep the strings of the list in an intern pool, every list using
+/// the pool shares one read-only buffer per distinct string, equals,
+/// indexOfArray, countArray and replaceArray then compare interned nodes by
+/// address, a node is given back its own copy before a case conversion changes
+/// it and nodes spliced in from another list move to the pool of this one
+///
+/// \param list   The list to intern
+/// \param intern The pool to share through, it must outlive the interning
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+bool SL_enableInterning(SL *list, STF_Intern *intern);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Give every string of the list its own copy again
+///
+/// \param list The list to stop interning
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+bool SL_disableInterning(SL *list);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Count a node in, or out of, the hash table of the list, the table
+/// is marked stale if it can't be updated, the key of a string is the chars
+/// of one of its nodes so removing that node while the string is still in
+/// the list also leaves the table stale
+///
+/// \param list       The list of the node
+/// \param stringNode The node that was added or is about to be removed
+///
+////////////////////////////////////////////////////////////////////////////////
+static void _SL_hashAdd(SL *list, SN *stringNode);
+static void _SL_hashRemove(SL *list, SN *stringNode);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Mark the hash table of the list stale, if there's one
+///
+/// \param list The list whose strings may have changed
 ///
 ////////////////////////////////////////////////////////////////////////////////
-static BN * BN_create(bool v);
-static CN * CN_create(char v);
-static IN * IN_create(int v);
-static DN * DN_create(double v);
-static SN * SN_create(String v);
+static void _SL_hashInvalidate(SL *list);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief Get the node address of the given index
+/// \brief Rebuild the hash table of the list if it's stale
 ///
-/// \param list  The list to get from
-/// \param index The index of the node
+/// \param list The list to check
 ///
-/// \return The address of the node, or NULL if it failed
+/// \return true if the list has a usable table, false otherwise
 ///
 ////////////////////////////////////////////////////////////////////////////////
-static BN * BL_getNode(BL *list, int index);
-static CN * CL_getNode(CL *list, int index);
-static IN * IL_getNode(IL *list, int index);
-static DN * DL_getNode(DL *list, int index);
-static SN * SL_getNode(SL *list, int index);
+static bool _SL_hashReady(SL *list);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief Create a new list object
+/// \brief Set the chars of a node of the list, keeping its hash table in sync
 ///
-/// \return A new list object, or NULL if it failed
+/// \param list       The list of the node
+/// \param stringNode The node to set
+/// \param chars      The chars to copy (_SL_setChars)
+/// \param length     The number of chars to copy (_SL_setChars)
+/// \param charList   The charList to copy (_SL_setList)
+///
+/// \return true if it's successful, false otherwise
 ///
 ////////////////////////////////////////////////////////////////////////////////
-BL * BL_create(void);
-CL * CL_create(void);
-IL * IL_create(void);
-DL * DL_create(void); 
-SL * SL_create(void);
+static bool _SL_setChars(SL *list, SN *stringNode, String chars, int length);
+static bool _SL_setList(SL *list, SN *stringNode, CL *charList);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Add a new node to the list
@@ -175,6 +1359,18 @@ bool DL_add(DL *list, double v);
 bool SL_addArray(SL *list, String v);
 bool SL_addList(SL *list, CL *v);
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Add a new node holding the first length chars of an array
+///
+/// \param list   The list to add to
+/// \param chars  The chars to copy
+/// \param length The number of chars to copy
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool _SL_addChars(SL *list, String chars, int length);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Adds a new node at the beginning of the list
 ///
@@ -254,6 +1450,9 @@ void SL_remove(SL *list, int index);
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Clear the list
 ///
+/// A pooled list releases its chunks at once, other lists free their nodes
+/// in one pass, clearing a view only empties the view
+///
 /// \param list The list to clear
 ///
 ////////////////////////////////////////////////////////////////////////////////
@@ -320,6 +1519,18 @@ String CL_toCharArray(CL *list);
 int * IL_toIntArray(IL *list);
 double * DL_toDoubleArray(DL *list); 
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Copy the chars of the list into a NUL terminated array
+///
+/// \param list  The list to copy
+/// \param isOut true for an array handed to the caller, false for one the
+///              library keeps and gives back with STF_release
+///
+/// \return The array, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static String _CL_chars(CL *list, bool isOut);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Convert the list to lowercase
 ///
@@ -347,9 +1558,48 @@ void SL_toUpperCase(SL *list);
 void CL_capitalize(CL *list);
 void SL_capitalize(SL *list);
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Compare two values for qsort
+///
+/// \param a The address of the first value
+/// \param b The address of the second value
+///
+/// \return A negative, zero or positive number if a comes first, ties or comes last
+///
+////////////////////////////////////////////////////////////////////////////////
+static int _IL_ascending(const void *a, const void *b);
+static int _DL_ascending(const void *a, const void *b);
+static int _IL_descending(const void *a, const void *b);
+static int _DL_descending(const void *a, const void *b);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Sort the list by relinking its nodes (stable merge sort, no allocation)
+///
+/// \param list       The list to sort
+/// \param isReversed The sorting direction if it's true(descending) or false(ascending)
+///
+////////////////////////////////////////////////////////////////////////////////
+static void _CL_sortNodes(CL *list, bool isReversed);
+static void _IL_sortNodes(IL *list, bool isReversed);
+static void _DL_sortNodes(DL *list, bool isReversed);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Sort an array of ints with a LSD radix sort (ascending)
+///
+/// \param array  The array to sort
+/// \param buffer A scratch array of the same length
+/// \param len    The length of the arrays
+///
+////////////////////////////////////////////////////////////////////////////////
+static void _IL_radixSort(int *array, int *buffer, int len);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief sort the given list
 ///
+/// BL and CL are counting sorted, IL is radix sorted on a flat copy of its
+/// values and DL is sorted with qsort on a flat copy, short lists use a
+/// comparison sort, if no memory is left the nodes are merge sorted in place
+///
 /// \param list The list to sort
 /// \param isReversed The sorting direction if it's true(descending) or false(ascending)
 ///
@@ -358,6 +1608,40 @@ static void _BL_sort(BL *list, bool isReversed);
 static void _CL_sort(CL *list, bool isReversed);
 static void _IL_sort(IL *list, bool isReversed);
 static void _DL_sort(DL *list, bool isReversed);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get a char of a sort key as a bucket number
+///
+/// \param key   The sort key
+/// \param depth The index of the char
+///
+/// \return 0 past the end of the key, otherwise the char's rank + 1
+///
+////////////////////////////////////////////////////////////////////////////////
+static int _SK_charAt(SK *key, int depth);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Sort an array of sort keys with a multikey quicksort (ascending)
+///
+/// \param keys  The keys to sort
+/// \param len   The number of keys
+/// \param depth The number of chars the keys are already known to share
+///
+////////////////////////////////////////////////////////////////////////////////
+static void _SK_sort(SK *keys, int len, int depth);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief sort the given list
+///
+/// The keys point at the chars of every node, they are sorted with a
+/// multikey quicksort and the nodes are relinked in the new order, if no
+/// memory is left the nodes are merge sorted in place with SN_compare
+///
+/// \param list The list to sort
+/// \param isReversed The sorting direction if it's true(descending) or false(ascending)
+///
+////////////////////////////////////////////////////////////////////////////////
+static void _SL_sortNodes(SL *list, bool isReversed);
 static void _SL_sort(SL *list, bool isReversed);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -385,7 +1669,127 @@ void DL_rsort(DL *list);
 void SL_rsort(SL *list);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief Create a list from an array
+/// \brief Look for a value with a walk, or over the node table four nodes at
+/// a time when the list has one
+///
+/// \param list      The list to search in
+/// \param v         The value to look for
+/// \param isCounted Whether to count every match instead of stopping at the
+///                  first one
+///
+/// \return The number of values equal to v when isCounted is true, otherwise
+///         the index of the first one or -1
+///
+////////////////////////////////////////////////////////////////////////////////
+static int _BL_scan(BL *list, bool v, bool isCounted);
+static int _CL_scan(CL *list, char v, bool isCounted);
+static int _IL_scan(IL *list, int v, bool isCounted);
+static int _DL_scan(DL *list, double v, bool isCounted);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Find where a value goes in a sorted list with a binary search over
+/// the node table (a linear walk if there's no table)
+///
+/// \param list    The list to search in
+/// \param v       The value to look for
+/// \param chars   The chars to look for (SL)
+/// \param length  The number of chars (SL)
+/// \param isUpper Whether to skip the values equal to v
+///
+/// \return The index of the first value not less than v, or greater than v
+///         when isUpper is true
+///
+////////////////////////////////////////////////////////////////////////////////
+static int _CL_bound(CL *list, char v, bool isUpper);
+static int _IL_bound(IL *list, int v, bool isUpper);
+static int _DL_bound(DL *list, double v, bool isUpper);
+static int _SL_bound(SL *list, String chars, int length, bool isUpper);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Compare the chars of a node with other chars, in the order SL_sort
+/// uses
+///
+/// \param stringNode The node to compare
+/// \param chars      The chars to compare with
+/// \param length     The number of chars
+///
+/// \return -1 if the node comes first, 1 if the chars do, 0 if they're equal
+///
+////////////////////////////////////////////////////////////////////////////////
+static int _SL_compareChars(SN *stringNode, String chars, int length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get the index of the first value of a sorted list that isn't less
+/// than v (lowerBound) or that's greater than v (upperBound)
+///
+/// The list must be in ascending order (see XL_sort), lists that are known
+/// to be sorted (isSorted) also use these for indexOf, contains and count
+///
+/// \param list The sorted list to search in
+/// \param v    The value to look for
+///
+/// \return The index, from 0 to list->size
+///
+////////////////////////////////////////////////////////////////////////////////
+int CL_lowerBound(CL *list, char v);
+int IL_lowerBound(IL *list, int v);
+int DL_lowerBound(DL *list, double v);
+int SL_lowerBound(SL *list, String v);
+int CL_upperBound(CL *list, char v);
+int IL_upperBound(IL *list, int v);
+int DL_upperBound(DL *list, double v);
+int SL_upperBound(SL *list, String v);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Find a value in a sorted list in O(log n)
+///
+/// \param list The sorted list to search in
+/// \param v    The value to look for
+///
+/// \return The index of the first match, -1 if none
+///
+////////////////////////////////////////////////////////////////////////////////
+int CL_binarySearch(CL *list, char v);
+int IL_binarySearch(IL *list, int v);
+int DL_binarySearch(DL *list, double v);
+int SL_binarySearch(SL *list, String v);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Insert a value into a sorted list after the values equal to it, so
+/// the list stays sorted
+///
+/// \param list The sorted list to insert into
+/// \param v    The value to insert
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CL_sortedInsert(CL *list, char v);
+bool IL_sortedInsert(IL *list, int v);
+bool DL_sortedInsert(DL *list, double v);
+bool SL_sortedInsert(SL *list, String v);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Append len values to the list in one go, the nodes are built as a
+/// chain (from a single pool chunk for pooled lists) and spliced onto the end
+/// of the list at once, nothing is added if it fails
+///
+/// \param list   The list to append to
+/// \param array  The values to append, or NULL to copy them from source
+/// \param source The first node to copy the values from when array is NULL
+/// \param len    The number of values to append
+///
+/// \return true if it's successful, false otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool _BL_append(BL *list, bool *array, BN *source, int len);
+static bool _CL_append(CL *list, String array, CN *source, int len);
+static bool _IL_append(IL *list, int *array, IN *source, int len);
+static bool _DL_append(DL *list, double *array, DN *source, int len);
+static bool _SL_append(SL *list, String *array, SN *source, int len);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a list from an array, its nodes come from a single pool chunk
 ///
 /// \param array The address of the array
 /// \param len   The length of the array, in case of char array no len param
@@ -400,7 +1804,8 @@ DL * DL_createFrom(double *array, int len);
 SL * SL_createFrom(String *array, int len);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief Create a new list from another list
+/// \brief Create a new list from another list, its nodes come from a single
+/// pool chunk
 ///
 /// \param list The list to copy
 ///
@@ -442,6 +1847,60 @@ bool IL_concatList(IL *listA, IL *listB);
 bool DL_concatList(DL *listA, DL *listB);
 bool SL_concat(SL *listA, SL *listB);
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Move the nodes of listB to the end of listA, listB is left empty
+///
+/// The nodes are relinked in constant time when both lists are malloc based
+/// or both have their own pool (listB's pool is merged into listA's),
+/// otherwise they are copied before listB is cleared, views and lists sharing
+/// their nodes with each other are refused
+///
+/// \param listA The list to move to
+/// \param listB The list to move from
+///
+/// \return false if it failed or the lists can't be spliced, true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+bool BL_concatListMove(BL *listA, BL *listB);
+bool CL_concatListMove(CL *listA, CL *listB);
+bool IL_concatListMove(IL *listA, IL *listB);
+bool DL_concatListMove(DL *listA, DL *listB);
+bool SL_concatMove(SL *listA, SL *listB);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Move the nodes of other into the list so that they start at the
+/// given index, other is left empty, see concatListMove for the cost
+///
+/// \param list  The list to move to
+/// \param index The index of the first moved node, from 0 to list->size
+/// \param other The list to move from, it can't be the list itself, a view
+///              or share its nodes with the list
+///
+/// \return false if it failed or the lists can't be spliced, true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+bool BL_spliceAt(BL *list, int index, BL *other);
+bool CL_spliceAt(CL *list, int index, CL *other);
+bool IL_spliceAt(IL *list, int index, IL *other);
+bool DL_spliceAt(DL *list, int index, DL *other);
+bool SL_spliceAt(SL *list, int index, SL *other);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Check that the nodes of other can be moved into the list, they
+/// can't when either list is a view or when other shares its nodes with it
+///
+/// \param list  The list to move to
+/// \param other The list to move from
+///
+/// \return true if the lists can be spliced, false otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool _BL_canSplice(BL *list, BL *other);
+static bool _CL_canSplice(CL *list, CL *other);
+static bool _IL_canSplice(IL *list, IL *other);
+static bool _DL_canSplice(DL *list, DL *other);
+static bool _SL_canSplice(SL *list, SL *other);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Reverse the list
 ///
@@ -456,6 +1915,22 @@ bool IL_reverse(IL *list);
 bool DL_reverse(DL *list);
 bool SL_reverse(SL *list);
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Reverse a part of the list in place
+///
+/// \param list  The list to reverse
+/// \param start The index of the first node of the part
+/// \param end   The index right after the last node of the part
+///
+/// \return false if the range is invalid and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+bool BL_reverseRange(BL *list, int start, int end);
+bool CL_reverseRange(CL *list, int start, int end);
+bool IL_reverseRange(IL *list, int start, int end);
+bool DL_reverseRange(DL *list, int start, int end);
+bool SL_reverseRange(SL *list, int start, int end);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Create a new list which is a piece from the original one
 ///
@@ -488,6 +1963,28 @@ IL * IL_sub(IL *list, int start, int length);
 DL * DL_sub(DL *list, int start, int length);
 SL * SL_sub(SL *list, int start, int length);
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get a read-only view of a piece of the list without copying it
+///
+/// The view shares the nodes (and node table) of the list, it's only valid
+/// until the list is changed and it must only be given to functions that
+/// don't change a list (get, contains, indexOf, count, compare, equals, print,
+/// toArray, copy...), it's never deleted
+///
+/// \param list  The list to look at
+/// \param start The index to start from
+/// \param end   The index to stop at (not included)
+///
+/// \return The view, it's empty if the range is invalid or if the list is
+///         packed (BL) since bits have no nodes to share
+///
+////////////////////////////////////////////////////////////////////////////////
+BL BL_view(BL *list, int start, int end);
+CL CL_view(CL *list, int start, int end);
+IL IL_view(IL *list, int start, int end);
+DL DL_view(DL *list, int start, int end);
+SL SL_view(SL *list, int start, int end);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Check if the list starts with the given value
 ///
@@ -689,6 +2186,28 @@ void DL_replace(DL *list, double oldValue, double newValue);
 bool SL_replaceArray(SL *list, String oldValue, String newValue);
 bool SL_replaceList(SL *list, String oldValue, CL *newValue);
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Combine two lists of the same size value by value, the result goes
+/// into the first list, a word at a time when both are packed
+///
+/// \param listA The list to change
+/// \param listB The list to combine with
+///
+/// \return false if the sizes differ and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+bool BL_and(BL *listA, BL *listB);
+bool BL_or(BL *listA, BL *listB);
+bool BL_xor(BL *listA, BL *listB);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Flip every value of the list
+///
+/// \param list The list to flip
+///
+////////////////////////////////////////////////////////////////////////////////
+void BL_not(BL *list);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Print the list to the Console
 ///
@@ -704,6 +2223,9 @@ void SL_print(SL *list);
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Call the callback function on each node of the list
 ///
+/// A packed BL hands the callback a node holding a copy of the bit, the
+/// value of that node is written back after the call
+///
 /// \param list The list to call on
 /// \param cb   The address of the callback function
 ///
@@ -714,6 +2236,19 @@ void IL_forEach(IL *list, void (*cb)(IL *, IN *, int));
 void DL_forEach(DL *list, void (*cb)(DL *, DN *, int));
 void SL_forEach(SL *list, void (*cb)(SL *, SN *, int));
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Call the callback function on each node of the list, from the last to the first
+///
+/// \param list The list to call on
+/// \param cb   The address of the callback function
+///
+////////////////////////////////////////////////////////////////////////////////
+void BL_forEachReverse(BL *list, void (*cb)(BL *, BN *, int));
+void CL_forEachReverse(CL *list, void (*cb)(CL *, CN *, int));
+void IL_forEachReverse(IL *list, void (*cb)(IL *, IN *, int));
+void DL_forEachReverse(DL *list, void (*cb)(DL *, DN *, int));
+void SL_forEachReverse(SL *list, void (*cb)(SL *, SN *, int));
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Call the callback function on each node of the list and then returns a new list
 ///
@@ -729,6 +2264,18 @@ IL * IL_map(IL *list, int (*cb)(IL *, IN *, int));
 DL * DL_map(DL *list, double (*cb)(DL *, DN *, int));
 SL * SL_map(SL *list, CL * (*cb)(SL *, SN *, int));
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Replace each value of the list with what the function returns for it
+///
+/// Unlike map, the function only gets the value, so the loop has no node or
+/// index to pass around and the list is changed in place
+///
+/// \param list The list to change
+/// \param fn   The address of the function
+///
+////////////////////////////////////////////////////////////////////////////////
+void IL_mapInPlace(IL *list, int (*fn)(int));
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Call the callback function on each node of the list and then returns a new filtered list
 ///
@@ -759,6 +2306,172 @@ bool IL_every(IL *list, bool (*cb)(IL *, IN *, int));
 bool DL_every(DL *list, bool (*cb)(DL *, DN *, int));
 bool SL_every(SL *list, bool (*cb)(SL *, SN *, int));
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get an iterator placed before the first node of the list
+///
+/// \param list The list to walk
+///
+/// \return The new iterator
+///
+////////////////////////////////////////////////////////////////////////////////
+BL_Iter BL_iterBegin(BL *list);
+CL_Iter CL_iterBegin(CL *list);
+IL_Iter IL_iterBegin(IL *list);
+DL_Iter DL_iterBegin(DL *list);
+SL_Iter SL_iterBegin(SL *list);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Move the iterator to the next node
+///
+/// \param iter The iterator to move
+///
+/// \return true if it's on a node now, false once it went past the last one
+///
+////////////////////////////////////////////////////////////////////////////////
+bool BL_iterNext(BL_Iter *iter);
+bool CL_iterNext(CL_Iter *iter);
+bool IL_iterNext(IL_Iter *iter);
+bool DL_iterNext(DL_Iter *iter);
+bool SL_iterNext(SL_Iter *iter);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Get the value of the current node
+///
+/// The String of SL_iterValue belongs to the list and must not be freed
+///
+/// \param iter The iterator to get from
+///
+/// \return The value of the node, or false, '\0', 0 and NULL if there's none
+///
+////////////////////////////////////////////////////////////////////////////////
+bool BL_iterValue(BL_Iter *iter);
+char CL_iterValue(CL_Iter *iter);
+int IL_iterValue(IL_Iter *iter);
+double DL_iterValue(DL_Iter *iter);
+String SL_iterValue(SL_Iter *iter);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Set the value of the current node
+///
+/// \param iter The iterator to set at
+/// \param v    The new value
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+bool BL_iterSet(BL_Iter *iter, bool v);
+bool CL_iterSet(CL_Iter *iter, char v);
+bool IL_iterSet(IL_Iter *iter, int v);
+bool DL_iterSet(DL_Iter *iter, double v);
+bool SL_iterSetArray(SL_Iter *iter, String v);
+bool SL_iterSetList(SL_Iter *iter, CL *v);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Insert a new node right after the current one, or at the start if
+/// the iterator is before the first node, the iterator doesn't move
+///
+/// \param iter The iterator to insert at
+/// \param v    The value of the node
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+bool BL_iterInsertAfter(BL_Iter *iter, bool v);
+bool CL_iterInsertAfter(CL_Iter *iter, char v);
+bool IL_iterInsertAfter(IL_Iter *iter, int v);
+bool DL_iterInsertAfter(DL_Iter *iter, double v);
+bool SL_iterInsertAfterArray(SL_Iter *iter, String v);
+bool SL_iterInsertAfterList(SL_Iter *iter, CL *v);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Remove the node right after the current one, or the first node if
+/// the iterator is before it, the iterator doesn't move
+///
+/// \param iter The iterator to remove at
+///
+/// \return false if there was no node to remove and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+bool BL_iterRemoveNext(BL_Iter *iter);
+bool CL_iterRemoveNext(CL_Iter *iter);
+bool IL_iterRemoveNext(IL_Iter *iter);
+bool DL_iterRemoveNext(DL_Iter *iter);
+bool SL_iterRemoveNext(SL_Iter *iter);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Build a hash set of the values of a list
+///
+/// \param list The list to read
+///
+/// \return The new set, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static STF_IntSet * _IL_toSet(IL *list);
+static STF_Hash * _SL_toHash(SL *list);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Add the values of source that aren't in seen yet to the list, in
+/// order, skipping the ones whose presence in filter isn't isKept
+///
+/// \param list   The list to add to
+/// \param source The list to read
+/// \param seen   The values added so far, it's updated
+/// \param filter The values to check against, or NULL to keep them all
+/// \param isKept Whether the values found in filter are kept or skipped
+///
+/// \return false if it failed and true otherwise
+///
+////////////////////////////////////////////////////////////////////////////////
+static bool _IL_addDistinct(IL *list, IL *source, STF_IntSet *seen, STF_IntSet *filter, bool isKept);
+static bool _SL_addDistinct(SL *list, SL *source, STF_Hash *seen, STF_Hash *filter, bool isKept);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Run a set operation on two lists in linear expected time
+///
+/// \param listA   The first list
+/// \param listB   The second list, or NULL to only remove duplicates of listA
+/// \param isUnion Whether the distinct values of listB are added after listA's
+/// \param isKept  Whether the values of listA found in listB are kept or not
+///
+/// \return A new pooled list, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+static IL * _IL_combine(IL *listA, IL *listB, bool isUnion, bool isKept);
+static SL * _SL_combine(SL *listA, SL *listB, bool isUnion, bool isKept);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Create a new list with the values of the list without duplicates,
+/// in the order of their first occurrence
+///
+/// \param list The list to read
+///
+/// \return The new list, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+IL * IL_unique(IL *list);
+SL * SL_unique(SL *list);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Set operations, every value shows up once in the result, in the
+/// order of its first occurrence in listA (then listB for the union)
+///
+/// intersect keeps the values of listA that are in listB, union keeps the
+/// values of both and difference keeps the values of listA that aren't in
+/// listB
+///
+/// \param listA The first list
+/// \param listB The second list
+///
+/// \return A new list, or NULL if it failed
+///
+////////////////////////////////////////////////////////////////////////////////
+IL * IL_intersect(IL *listA, IL *listB);
+IL * IL_union(IL *listA, IL *listB);
+IL * IL_difference(IL *listA, IL *listB);
+SL * SL_intersect(SL *listA, SL *listB);
+SL * SL_union(SL *listA, SL *listB);
+SL * SL_difference(SL *listA, SL *listB);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Split the CL object into a SL object depending on a separator(char)
 ///
@@ -771,20 +2484,43 @@ bool SL_every(SL *list, bool (*cb)(SL *, SN *, int));
 static SL * CL_splitc(CL *charList, char sep);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief Get a piece of a CL object as a String
+/// \brief Find the first occurrence of a separator in a flat array of chars
+///
+/// memchr skips to every candidate first byte and memcmp checks the rest
+///
+/// \param chars     The chars to search in
+/// \param length    The number of chars to search in
+/// \param sep       The separator to look for
+/// \param sepLength The length of the separator (at least 1)
+///
+/// \return The address of the match, or NULL if none
+///
+////////////////////////////////////////////////////////////////////////////////
+static String _CL_search(String chars, int length, String sep, int sepLength);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Split a flat array of chars into a new pooled SL object in one scan
 ///
-/// \param charList The List to substr
-/// \param start    The starting index
-/// \param length   The length of the sub string
+/// Each field is copied into its own node since a node owns its chars, fields
+/// shorter than STF_SHORT_LENGTH land inside the node and longer ones get one
+/// heap buffer each
 ///
-/// \return The sub string 
+/// \param chars     The chars to split
+/// \param length    The number of chars
+/// \param sep       The separator
+/// \param sepLength The length of the separator, 0 keeps the chars whole
+///
+/// \return A new SL object, or NULL if it failed
 ///
 ////////////////////////////////////////////////////////////////////////////////
-static String _CL_substr(CL *charList, int start, int length);
+static SL * _CL_splitChars(String chars, int length, String sep, int sepLength);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Split the CL object into a SL object depending on a separator(String)
 ///
+/// The chars are flattened into one temporary array first, then every field
+/// is copied out of it into the new list
+///
 /// \param charList List to split
 /// \param sep      The separator
 ///
@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// STF_Lists tests - each test_*.c file is a program that checks one part of
+// the library and exits with a non zero status if a check failed
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STF_TEST_H
+#define STF_TEST_H
+
+#include "STF_Lists.h"
+
+static int STF_testFailures = 0;
+
+// a failed check is reported and the test keeps going so one run shows them all
+#define CHECK(condition) do { \
+  if(!(condition)) { \
+    printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+    STF_testFailures++; \
+  } \
+} while(0)
+
+// compare a string got from the library with the expected one and free it
+#define CHECK_STRING(got, expected) do { \
+  String _got = (got); \
+  CHECK(_got != NULL && strcmp(_got, expected) == 0); \
+  STF_free(_got); \
+} while(0)
+
+// the chars of a string node, wherever the node keeps them
+static String nodeChars(SN *node) {
+  return node->isShort ? node->storage.shortChars : node->storage.chars;
+}
+
+// an allocator that keeps the number of bytes in use, each block starts with its size
+static size_t liveBytes = 0;
+
+static void * countingAlloc(void *context, size_t size) {
+  size_t *block = (size_t *)malloc(size + sizeof(size_t) * 2);
+  if(block == NULL) {
+    return NULL;
+  }
+  *block = size;
+  liveBytes += size;
+  return block + 2;
+}
+
+static void * countingRealloc(void *context, void *memory, size_t size) {
+  if(memory == NULL) {
+    return countingAlloc(context, size);
+  }
+  size_t *block = (size_t *)realloc((size_t *)memory - 2, size + sizeof(size_t) * 2);
+  if(block == NULL) {
+    return NULL;
+  }
+  liveBytes += size - *block;
+  *block = size;
+  return block + 2;
+}
+
+static void countingFree(void *context, void *memory) {
+  size_t *block = (size_t *)memory - 2;
+  liveBytes -= *block;
+  free(block);
+}
+
+static const STF_Allocator countingAllocator = {countingAlloc, countingRealloc, countingFree, NULL};
+
+#define TEST_RESULT() (STF_testFailures == 0 ? 0 : 1)
+
+#endif
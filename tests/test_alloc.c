@@ -0,0 +1,131 @@
+#include "test.h"
+
+typedef struct {
+  long live;
+  long calls;
+} Counts;
+
+static void * countAlloc(void *context, size_t size) {
+  Counts *counts = (Counts *)context;
+  counts->live++;
+  counts->calls++;
+  return malloc(size);
+}
+
+static void * countRealloc(void *context, void *memory, size_t size) {
+  Counts *counts = (Counts *)context;
+  counts->live += memory == NULL;
+  counts->calls++;
+  return realloc(memory, size);
+}
+
+static void countFree(void *context, void *memory) {
+  ((Counts *)context)->live--;
+  free(memory);
+}
+
+static Counts globalCounts, ownCounts;
+static const STF_Allocator globalAllocator = {countAlloc, countRealloc, countFree, &globalCounts};
+static const STF_Allocator ownAllocator = {countAlloc, countRealloc, countFree, &ownCounts};
+
+// every block goes back to the allocator it came from
+static void testPairs() {
+  IL *list = IL_create();
+  for(int i = 0;i < 1000;i++) {
+    IL_add(list, i);
+  }
+  IL_get(list, 3);
+  STF_free(IL_toIntArray(list));
+  SL *strings = SL_createPooled();
+  SL_enableHash(strings);
+  SL_addArray(strings, "x");
+  CHECK_STRING(SL_get(strings, 0), "x");
+  IL *own = IL_createWith(&ownAllocator);
+  for(int i = 0;i < 1000;i++) {
+    IL_add(own, i);
+  }
+  CHECK(ownCounts.calls > 0);
+  CHECK(IL_concatListMove(own, list) && own->size == 2000 && IL_get(own, 1999) == 999);
+  IL *other = IL_createWith(&ownAllocator);
+  IL_add(other, 1);
+  CHECK(IL_concatListMove(own, other) && IL_get(own, 2000) == 1);
+  IL_delete(other);
+  CHECK(IL_compact(own) && IL_get(own, 1500) == 500);
+  STF_Arena *arena = STF_Arena_create();
+  IL_add(IL_createIn(arena), 2);
+  STF_Arena_delete(arena);
+  IL_delete(list);
+  IL_delete(own);
+  SL_delete(strings);
+  CHECK(globalCounts.live == 0 && globalCounts.calls > 0 && ownCounts.live == 0);
+}
+
+// a list with its own allocator keeps its tables there too
+static void testOwnTables() {
+  long calls = globalCounts.calls;
+  IL *ints = IL_createWith(&ownAllocator);
+  BL *bools = BL_createWith(&ownAllocator);
+  SL *strings = SL_createWith(&ownAllocator);
+  CHECK(SL_enableHash(strings));
+  for(int i = 0;i < 1000;i++) {
+    IL_add(ints, i);
+    BL_add(bools, i % 3 == 0);
+    SL_addArray(strings, i % 2 == 0 ? "even" : "odd");
+  }
+  CHECK(IL_get(ints, 500) == 500 && BL_get(bools, 9));
+  CHECK(BL_pack(bools) && BL_add(bools, true) && BL_get(bools, 1000) && !BL_get(bools, 998));
+  CHECK(SL_countArray(strings, "odd") == 500 && SL_containsArray(strings, "even"));
+  CHECK(globalCounts.calls == calls);
+  IL_delete(ints);
+  BL_delete(bools);
+  SL_delete(strings);
+  CHECK(ownCounts.live == 0);
+}
+
+static void addMark(SL *list, SN *node, int index) {
+  CL_add(node->value, '!');
+}
+
+// the allocator can't change while blocks from it are still out
+static void testSwap() {
+  IL *list = IL_create();
+  IL_add(list, 1);
+  CHECK(!STF_setAllocator(NULL));
+  CHECK(STF_setAllocator(&globalAllocator));
+  // arrays handed out aren't held against the allocator, the caller gives them back
+  int *array = IL_toIntArray(list);
+  IL_delete(list);
+  STF_free(array);
+  CHECK(globalCounts.live == 0 && STF_setAllocator(NULL));
+  // with the default allocator plain free keeps working
+  list = IL_create();
+  IL_add(list, 1);
+  free(IL_toIntArray(list));
+  IL_delete(list);
+  // chars folded back from a callback are the list's own again
+  SL *strings = SL_create();
+  SL_addArray(strings, "a string too long for the short buffer");
+  SL_forEach(strings, addMark);
+  CHECK(SL_indexOfArray(strings, "a string too long for the short buffer!") == 0);
+  CHECK(!STF_setAllocator(&globalAllocator));
+  SL_delete(strings);
+  CHECK(STF_setAllocator(&globalAllocator) && STF_setAllocator(NULL));
+  // lists with their own allocator don't hold the global one
+  IL *own = IL_createWith(&ownAllocator);
+  IL_add(own, 1);
+  CHECK(STF_setAllocator(&globalAllocator) && STF_setAllocator(NULL));
+  IL_delete(own);
+  long calls = globalCounts.calls;
+  list = IL_create();
+  IL_add(list, 1);
+  IL_delete(list);
+  CHECK(globalCounts.calls == calls && ownCounts.live == 0);
+}
+
+int main() {
+  CHECK(STF_setAllocator(&globalAllocator));
+  testPairs();
+  testOwnTables();
+  testSwap();
+  return TEST_RESULT();
+}
@@ -0,0 +1,63 @@
+#include "test.h"
+
+static void fillRound(STF_Arena *arena) {
+  IL *listA = IL_createIn(arena), *listB = IL_createIn(arena);
+  CHECK(listA != NULL && listB != NULL);
+  for(int i = 0;i < 10000;i++) {
+    IL_add(listA, i);
+    IL_unshift(listB, i);
+  }
+  CHECK(IL_get(listA, 9999) == 9999 && IL_get(listB, 0) == 9999);
+  // nodes move between lists of the same arena and are copied across allocators
+  CHECK(IL_concatListMove(listA, listB) && listA->size == 20000 && IL_get(listA, 10000) == 9999);
+  IL *pooled = IL_createPooled();
+  IL_add(pooled, -1);
+  CHECK(IL_concatListMove(listA, pooled) && IL_get(listA, 20000) == -1);
+  IL_delete(pooled);
+  IL *heap = IL_create();
+  IL_add(heap, 5);
+  CHECK(IL_concatListMove(heap, listA) && heap->size == 20002 && IL_get(heap, 20001) == -1 && listA->size == 0);
+  IL_delete(heap);
+  SL *strings = SL_createIn(arena);
+  SL_enableHash(strings);
+  for(int i = 0;i < 1000;i++) {
+    SL_addArray(strings, i % 2 == 1 ? "odd" : "an even word too long for the short buffer");
+  }
+  CHECK(SL_countArray(strings, "odd") == 500);
+  CL *chars = CL_createFromIn(arena, "hello arena");
+  CHECK(chars->size == 11 && CL_get(chars, 6) == 'a');
+  CHECK(CL_compact(chars) && CL_get(chars, 0) == 'h');
+  BL *bools = BL_createIn(arena);
+  for(int i = 0;i < 100;i++) {
+    BL_add(bools, i % 2 == 1);
+  }
+  CHECK(BL_pack(bools) && BL_count(bools, true) == 50);
+  DL *doubles = DL_createIn(arena);
+  DL_add(doubles, 2.5);
+  DL_delete(doubles);
+  IL_clear(listB);
+  IL_add(listB, 7);
+}
+
+// reset releases what the lists hold on the heap and keeps one block
+static void testRounds() {
+  size_t before = liveBytes, afterReset = 0;
+  STF_Arena *arena = STF_Arena_create();
+  CHECK(arena != NULL);
+  for(int round = 0;round < 3;round++) {
+    fillRound(arena);
+    STF_Arena_reset(arena);
+    CHECK(arena->lists == NULL && arena->blocks != NULL);
+    CHECK(round == 0 || liveBytes == afterReset);
+    afterReset = liveBytes;
+  }
+  STF_Arena_delete(arena);
+  STF_Arena_delete(NULL);
+  CHECK(liveBytes == before);
+}
+
+int main() {
+  STF_setAllocator(&countingAllocator);
+  testRounds();
+  return TEST_RESULT();
+}
@@ -0,0 +1,105 @@
+#include "test.h"
+
+static void testValues() {
+  int ints[1000];
+  for(int i = 0;i < 1000;i++) {
+    ints[i] = i;
+  }
+  IL *list = IL_createFrom(ints, 1000);
+  CHECK(list->size == 1000 && list->end->value == 999 && IL_get(list, 500) == 500);
+  IL_concatList(list, list);
+  CHECK(list->size == 2000 && IL_get(list, 1999) == 999 && list->end->value == 999 && IL_get(list, 1000) == 0);
+  IL *small = IL_create();
+  IL_concatArray(small, ints, 0);
+  CHECK(small->size == 0 && small->start == NULL);
+  IL_concatArray(small, ints, 3);
+  IL_get(small, 1);
+  IL_concatArray(small, ints + 3, 5);
+  CHECK(IL_get(small, 7) == 7 && small->end->value == 7);
+  IL *copy = IL_copy(small);
+  CHECK(IL_equalsList(copy, small));
+  IL_pop(copy);
+  IL_shift(copy);
+  CHECK(copy->size == 6 && copy->end->value == 6);
+  IL *slice = IL_slice(list, 998, 1003);
+  CHECK(slice->size == 5 && IL_get(slice, 0) == 998 && IL_get(slice, 2) == 0 && slice->end->value == 2);
+  IL *sub = IL_sub(list, 1990, 50);
+  CHECK(sub->size == 10 && sub->end->value == 999);
+  IL_delete(list);
+  IL_delete(small);
+  IL_delete(copy);
+  IL_delete(slice);
+  IL_delete(sub);
+
+  CL *chars = CL_createFrom("hello");
+  CL_concatArray(chars, " world");
+  CL *charsCopy = CL_copy(chars);
+  CHECK(CL_equalsArray(charsCopy, "hello world"));
+  CL_concatList(charsCopy, chars);
+  CHECK(charsCopy->size == 22);
+  CL_delete(chars);
+  CL_delete(charsCopy);
+
+  SL *strings = SL_createFrom((String []){"a", "bc", ""}, 3);
+  SL_concat(strings, strings);
+  SL *stringsCopy = SL_copy(strings);
+  CHECK(strings->size == 6 && SL_equals(strings, stringsCopy) && SL_endsWithArray(stringsCopy, ""));
+  SL_delete(strings);
+  SL_delete(stringsCopy);
+
+  DL *doubles = DL_createFrom((double []){1.5, 2.5}, 2);
+  DL_concatList(doubles, doubles);
+  CHECK(doubles->size == 4 && DL_get(doubles, 3) == 2.5);
+  DL_delete(doubles);
+}
+
+// a list built in bulk takes about as much memory as one built node by node
+static void testSmallLists() {
+  size_t before = liveBytes;
+  CL *added = CL_create();
+  CL_add(added, 'a');
+  CL_add(added, 'b');
+  CL_add(added, 'c');
+  size_t addedBytes = liveBytes - before;
+  CL *built = CL_createFrom("abc");
+  size_t builtBytes = liveBytes - before - addedBytes;
+  CHECK(builtBytes < addedBytes * 2);
+  CL_delete(added);
+  CL_delete(built);
+
+  before = liveBytes;
+  IL *ints = IL_createFrom((int []){1, 2, 3}, 3);
+  CHECK(liveBytes - before < addedBytes * 2);
+  IL_delete(ints);
+
+  before = liveBytes;
+  CL *line = CL_createFrom("a,b,c");
+  SL *fields = CL_split(line, ",");
+  CHECK(liveBytes - before < 1024);
+  SL_delete(fields);
+  CL_delete(line);
+  CHECK(liveBytes == 0);
+}
+
+// nodes added one at a time still come from chunks that double in length
+static void testIncrementalGrowth() {
+  IL *list = IL_createFrom((int []){1, 2, 3}, 3);
+  for(int i = 0;i < 1000;i++) {
+    IL_add(list, i);
+  }
+  int chunks = 0;
+  for(void *chunk = list->pool->chunks;chunk != NULL;chunk = *(void **)chunk) {
+    chunks++;
+  }
+  CHECK(chunks <= 10);
+  CHECK(IL_get(list, 1002) == 999);
+  IL_delete(list);
+}
+
+int main() {
+  STF_setAllocator(&countingAllocator);
+  testValues();
+  testSmallLists();
+  testIncrementalGrowth();
+  return TEST_RESULT();
+}
@@ -0,0 +1,70 @@
+#include "test.h"
+
+static int twice(int v) {
+  return v * 2;
+}
+
+// the lookup table must give what tolower and toupper give for every byte
+static void testEveryChar() {
+  CL *list = CL_create();
+  for(int c = 1;c < 256;c++) {
+    CL_add(list, (char)c);
+  }
+  CL_toUpperCase(list);
+  bool isUpper = true;
+  CN *node = list->start;
+  for(int c = 1;c < 256;c++) {
+    isUpper = isUpper && (unsigned char)node->value == toupper(c);
+    node = node->next;
+  }
+  CHECK(isUpper);
+  CL_toLowerCase(list);
+  bool isLower = true;
+  node = list->start;
+  for(int c = 1;c < 256;c++) {
+    isLower = isLower && (unsigned char)node->value == tolower(toupper(c));
+    node = node->next;
+  }
+  CHECK(isLower);
+  CL_delete(list);
+}
+
+static void testLists() {
+  CL *chars = CL_createFrom("Hello, World! \xe9");
+  CL_toUpperCase(chars);
+  CHECK_STRING(CL_toCharArray(chars), "HELLO, WORLD! \xe9");
+  CL_toLowerCase(chars);
+  CHECK_STRING(CL_toCharArray(chars), "hello, world! \xe9");
+  CL_delete(chars);
+  SL *strings = SL_create();
+  SL_addArray(strings, "AbC");
+  SL_addArray(strings, "xYz and a word too long for the short buffer");
+  SL_enableHash(strings);
+  SL_toLowerCase(strings);
+  CHECK(SL_containsArray(strings, "abc") && !SL_containsArray(strings, "AbC"));
+  CHECK(SL_containsArray(strings, "xyz and a word too long for the short buffer"));
+  SL_toUpperCase(strings);
+  CHECK_STRING(SL_get(strings, 0), "ABC");
+  CHECK_STRING(SL_get(strings, 1), "XYZ AND A WORD TOO LONG FOR THE SHORT BUFFER");
+  SL_delete(strings);
+}
+
+static void testMapInPlace() {
+  int values[] = {3, -1, 2};
+  IL *list = IL_createFrom(values, 3);
+  IL_sort(list);
+  IL_mapInPlace(list, twice);
+  int expected[] = {-2, 4, 6};
+  CHECK(IL_equalsArray(list, expected, 3) && !list->isSorted);
+  IL_clear(list);
+  IL_mapInPlace(list, twice);
+  CHECK(list->size == 0);
+  IL_delete(list);
+}
+
+int main() {
+  testEveryChar();
+  testLists();
+  testMapInPlace();
+  return TEST_RESULT();
+}
@@ -0,0 +1,88 @@
+#include "test.h"
+
+static void testIntegers() {
+  IL *list = IL_create(), *pooled = IL_createPooled();
+  for(int i = 0;i < 1000;i++) {
+    IL_add(list, 1000 - i);
+    IL_add(pooled, i);
+  }
+  IL_get(list, 5);
+  // a view only forgets its own range
+  IL view = IL_view(pooled, 10, 20);
+  IL_clear(&view);
+  CHECK(view.size == 0 && pooled->size == 1000 && IL_get(pooled, 15) == 15);
+  IL_clear(list);
+  IL_clear(pooled);
+  CHECK(list->size == 0 && list->start == NULL && list->end == NULL && list->isSorted);
+  CHECK(pooled->size == 0 && pooled->start == NULL && pooled->pool->chunks == NULL);
+  IL_add(list, 3);
+  IL_unshift(list, 1);
+  IL_add(pooled, 4);
+  CHECK(IL_get(list, 1) == 3 && IL_indexOf(list, 3) == 1 && IL_get(pooled, 0) == 4 && pooled->size == 1);
+  IL_delete(list);
+  IL_delete(pooled);
+}
+
+static void upperCase(SL *list, SN *node, int index) {
+  CL_toUpperCase(node->value);
+}
+
+static void testOtherTypes() {
+  SL *pooled = SL_createPooled(), *hashed = SL_create();
+  SL_enableHash(hashed);
+  for(int i = 0;i < 500;i++) {
+    SL_addArray(pooled, i % 2 == 0 ? "abc" : "a word too long for the short buffer");
+    SL_addArray(hashed, "xyz");
+  }
+  // the callback leaves a charList on each node
+  SL_forEach(pooled, upperCase);
+  SL_clear(pooled);
+  SL_clear(hashed);
+  CHECK(pooled->size == 0 && !SL_containsArray(hashed, "xyz"));
+  SL_addArray(hashed, "q");
+  SL_addArray(pooled, "r");
+  CHECK(SL_containsArray(hashed, "q") && SL_countArray(hashed, "q") == 1);
+  CHECK_STRING(SL_get(pooled, 0), "r");
+  SL_delete(pooled);
+  SL_delete(hashed);
+  BL *packed = BL_createPacked();
+  BL_add(packed, true);
+  BL_clear(packed);
+  CHECK(packed->size == 0 && packed->isPacked && BL_count(packed, true) == 0);
+  BL_add(packed, false);
+  CHECK(BL_count(packed, true) == 0 && packed->size == 1);
+  BL_delete(packed);
+  CL *chars = CL_createFrom("hello");
+  CL_clear(chars);
+  CL_add(chars, 'x');
+  CHECK_STRING(CL_toCharArray(chars), "x");
+  CL_delete(chars);
+  DL *doubles = DL_createPooled();
+  DL_add(doubles, 1);
+  DL_clear(doubles);
+  CHECK(doubles->size == 0);
+  DL_delete(doubles);
+}
+
+// clearing gives every node back
+static void testMemory() {
+  size_t before = liveBytes;
+  IL *list = IL_create(), *pooled = IL_createPooled();
+  for(int i = 0;i < 5000;i++) {
+    IL_add(list, i);
+    IL_add(pooled, i);
+  }
+  IL_clear(list);
+  IL_clear(pooled);
+  IL_delete(list);
+  IL_delete(pooled);
+  CHECK(liveBytes == before);
+}
+
+int main() {
+  STF_setAllocator(&countingAllocator);
+  testIntegers();
+  testOtherTypes();
+  testMemory();
+  return TEST_RESULT();
+}
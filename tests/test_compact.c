@@ -0,0 +1,77 @@
+#include "test.h"
+
+static bool isSequential(IL *list) {
+  IN *node = list->start;
+  for(int i = 1;i < list->size;i++) {
+    if(node->next != node + 1) {
+      return false;
+    }
+    node = node->next;
+  }
+  return list->size == 0 || (node == list->end && node->next == NULL);
+}
+
+// after compact the nodes sit next to each other in list order
+static void testScattered() {
+  IL *list = IL_create();
+  for(int i = 0;i < 1000;i++) {
+    IL_insert(list, i, i / 2);
+  }
+  int *before = IL_toIntArray(list);
+  IL_get(list, 10);
+  CHECK(IL_compact(list) && list->pool != NULL && isSequential(list));
+  CHECK(IL_equalsArray(list, before, 1000));
+  bool isIndexed = list->isIndexed;
+  for(int i = 0;i < 1000;i += 37) {
+    isIndexed = isIndexed && IL_get(list, i) == before[i];
+  }
+  CHECK(isIndexed);
+  IL_add(list, 5);
+  IL_remove(list, 3);
+  CHECK(IL_get(list, 999) == 5 && IL_compact(list) && isSequential(list));
+  STF_free(before);
+  IL_delete(list);
+  IL *pooled = IL_createPooled();
+  for(int i = 0;i < 100;i++) {
+    IL_unshift(pooled, i);
+  }
+  CHECK(IL_compact(pooled) && isSequential(pooled) && IL_get(pooled, 0) == 99);
+  IL view = IL_view(pooled, 0, 3);
+  CHECK(!IL_compact(&view));
+  IL_delete(pooled);
+}
+
+static void testOtherTypes() {
+  SL *strings = SL_create();
+  SL_addArray(strings, "a");
+  SL_addArray(strings, "a word too long for the short buffer");
+  SL_enableHash(strings);
+  CHECK(SL_compact(strings));
+  CHECK(SL_containsArray(strings, "a word too long for the short buffer") && SL_countArray(strings, "a") == 1);
+  CHECK_STRING(SL_get(strings, 0), "a");
+  SL_delete(strings);
+  SL *empty = SL_create();
+  SL_compact(empty);
+  SL_addArray(empty, "x");
+  CHECK(empty->size == 1);
+  SL_delete(empty);
+  BL *bools = BL_create();
+  BL_add(bools, true);
+  BL_add(bools, false);
+  CHECK(BL_compact(bools) && BL_get(bools, 0) && !BL_get(bools, 1));
+  BL_delete(bools);
+  CL *chars = CL_createFrom("xyz");
+  CHECK(CL_compact(chars));
+  CHECK_STRING(CL_toCharArray(chars), "xyz");
+  CL_delete(chars);
+  DL *doubles = DL_create();
+  DL_add(doubles, 1.5);
+  CHECK(DL_compact(doubles) && DL_get(doubles, 0) == 1.5);
+  DL_delete(doubles);
+}
+
+int main() {
+  testScattered();
+  testOtherTypes();
+  return TEST_RESULT();
+}
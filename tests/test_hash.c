@@ -0,0 +1,132 @@
+#include "test.h"
+
+static const char *words[] = {"a", "bb", "", "ccc", "a2", "zz", "Q", "a word too long for the short buffer"};
+#define WORD_COUNT 8
+
+static void upperCase(SL *list, SN *node, int index) {
+  CL_toUpperCase(node->value);
+}
+
+// the same edits on a hashed list and a plain one must give the same answers
+static void testAgainstPlainList(bool isPooled) {
+  srand(11);
+  SL *hashed = isPooled ? SL_createPooled() : SL_create(), *plain = SL_create();
+  CHECK(SL_enableHash(hashed));
+  for(int step = 0;step < 20000;step++) {
+    String word = (String)words[rand() % WORD_COUNT], other = (String)words[rand() % WORD_COUNT];
+    int index = hashed->size == 0 ? 0 : rand() % hashed->size;
+    switch(rand() % 15) {
+      case 0: case 1: SL_addArray(hashed, word); SL_addArray(plain, word); break;
+      case 2: SL_unshiftArray(hashed, word); SL_unshiftArray(plain, word); break;
+      case 3: SL_insertArray(hashed, word, index); SL_insertArray(plain, word, index); break;
+      case 4: SL_remove(hashed, index); SL_remove(plain, index); break;
+      case 5: SL_pop(hashed); SL_pop(plain); break;
+      case 6: SL_shift(hashed); SL_shift(plain); break;
+      case 7: SL_setArray(hashed, word, index); SL_setArray(plain, word, index); break;
+      case 8: SL_replaceArray(hashed, word, other); SL_replaceArray(plain, word, other); break;
+      case 9:
+        if(rand() % 20 == 0) {
+          SL_forEach(hashed, upperCase);
+          SL_forEach(plain, upperCase);
+        }
+        break;
+      case 10: {
+        SL_Iter iter = SL_iterBegin(hashed), plainIter = SL_iterBegin(plain);
+        if(SL_iterNext(&iter) && SL_iterNext(&plainIter)) {
+          SL_iterInsertAfterArray(&iter, word);
+          SL_iterInsertAfterArray(&plainIter, word);
+          SL_iterRemoveNext(&iter);
+          SL_iterRemoveNext(&plainIter);
+        }
+        break;
+      }
+      case 11:
+        if(rand() % 50 == 0) {
+          SL_clear(hashed);
+          SL_clear(plain);
+        }
+        break;
+      case 12: {
+        SL *moved = SL_create();
+        SL_addArray(moved, word);
+        SL_concatMove(hashed, moved);
+        SL_addArray(plain, word);
+        SL_delete(moved);
+        break;
+      }
+      case 13:
+        if(rand() % 10 == 0) {
+          SL_toLowerCase(hashed);
+          SL_toLowerCase(plain);
+        }
+        break;
+      case 14:
+        if(rand() % 10 == 0) {
+          SL_compact(hashed);
+        }
+        break;
+    }
+    for(int k = 0;k < WORD_COUNT;k++) {
+      String query = (String)words[k];
+      char upper[64];
+      strcpy(upper, query);
+      upper[0] = toupper(upper[0]);
+      CHECK(SL_countArray(hashed, query) == SL_countArray(plain, query));
+      CHECK(SL_indexOfArray(hashed, query) == SL_indexOfArray(plain, query));
+      CHECK(SL_containsArray(hashed, upper) == SL_containsArray(plain, upper));
+      CHECK(SL_lastIndexOfArray(hashed, upper) == SL_lastIndexOfArray(plain, upper));
+    }
+    CHECK(SL_equals(hashed, plain));
+  }
+  SL_disableHash(hashed);
+  SL_delete(hashed);
+  SL_delete(plain);
+}
+
+static void testGrowth() {
+  SL *list = SL_create();
+  SL_enableHash(list);
+  char key[16];
+  for(int i = 0;i < 50000;i++) {
+    sprintf(key, "k%d", i % 20000);
+    SL_addArray(list, key);
+  }
+  bool isCounted = true;
+  for(int i = 0;i < 20000;i++) {
+    sprintf(key, "k%d", i);
+    isCounted = isCounted && SL_countArray(list, key) == (i < 10000 ? 3 : 2);
+  }
+  for(int i = 0;i < 25000;i++) {
+    SL_shift(list);
+  }
+  for(int i = 0;i < 20000;i++) {
+    sprintf(key, "k%d", i);
+    isCounted = isCounted && SL_countArray(list, key) == (i < 5000 ? 1 : i < 10000 ? 2 : 1);
+  }
+  CHECK(isCounted && list->hash->size == 20000);
+  SL_delete(list);
+}
+
+// the table points at the chars of the nodes instead of keeping a copy of each string
+static void testNoKeyCopies() {
+  SL *list = SL_create();
+  char key[64];
+  for(int i = 0;i < 1000;i++) {
+    sprintf(key, "a dictionary word long enough to be on the heap %d", i);
+    SL_addArray(list, key);
+  }
+  size_t before = liveBytes;
+  SL_enableHash(list);
+  CHECK(liveBytes - before <= sizeof(STF_Hash) + 2048 * sizeof(STF_HashEntry));
+  CHECK(SL_containsArray(list, key) && SL_countArray(list, "a dictionary word") == 0);
+  SL_delete(list);
+}
+
+int main() {
+  STF_setAllocator(&countingAllocator);
+  testAgainstPlainList(false);
+  testAgainstPlainList(true);
+  testGrowth();
+  testNoKeyCopies();
+  return TEST_RESULT();
+}
@@ -0,0 +1,125 @@
+#include "test.h"
+
+#define STEPS 20000
+
+static int shadow[STEPS];
+static int length;
+
+static bool matchesShadow(IL *list) {
+  if(list->size != length) {
+    return false;
+  }
+  IN *node = list->start;
+  for(int i = 0;i < length;i++) {
+    if(node->value != shadow[i] || IL_get(list, i) != shadow[i]) {
+      return false;
+    }
+    node = node->next;
+  }
+  return length == 0 || list->end->value == shadow[length - 1];
+}
+
+// random edits checked against a plain array, reads by index go through the node table
+static void testRandomEdits(IL *list) {
+  srand(7);
+  length = 0;
+  for(int step = 0;step < STEPS;step++) {
+    int op = rand() % 9, v = rand() % 1000, i = length == 0 ? 0 : rand() % length;
+    if(op < 3) {
+      IL_add(list, v);
+      shadow[length++] = v;
+    }else if(op == 3) {
+      IL_unshift(list, v);
+      memmove(shadow + 1, shadow, length * sizeof(int));
+      shadow[0] = v;
+      length++;
+    }else if(op == 4) {
+      IL_insert(list, v, i);
+      memmove(shadow + i + 1, shadow + i, (length - i) * sizeof(int));
+      shadow[i] = v;
+      length++;
+    }else if(op == 5 && length > 0) {
+      CHECK(IL_remove(list, i) == shadow[i]);
+      memmove(shadow + i, shadow + i + 1, (length - i - 1) * sizeof(int));
+      length--;
+    }else if(op == 6 && length > 0) {
+      CHECK(IL_pop(list) == shadow[--length]);
+    }else if(op == 7 && length > 0) {
+      CHECK(IL_shift(list) == shadow[0]);
+      memmove(shadow, shadow + 1, (length - 1) * sizeof(int));
+      length--;
+    }else if(op == 8 && length > 0) {
+      IL_set(list, v, i);
+      shadow[i] = v;
+    }
+    if(length > 0) {
+      CHECK(IL_get(list, i < length ? i : 0) == shadow[i < length ? i : 0]);
+    }
+    if(step % 1000 == 0) {
+      CHECK(matchesShadow(list));
+    }
+  }
+  CHECK(matchesShadow(list));
+  IL_clear(list);
+  length = 0;
+  CHECK(matchesShadow(list));
+  IL_add(list, 3);
+  CHECK(IL_get(list, 0) == 3 && list->end->value == 3);
+}
+
+static void testStrings() {
+  SL *list = SL_create();
+  SL_addArray(list, "a");
+  SL_addArray(list, "b");
+  SL_insertArray(list, "c", 1);
+  SL_unshiftArray(list, "z");
+  CHECK_STRING(SL_get(list, 2), "c");
+  SL_remove(list, 2);
+  CHECK_STRING(SL_get(list, 2), "b");
+  CHECK_STRING(SL_get(list, 0), "z");
+  SL_delete(list);
+}
+
+static int reverseCount, reverseValues[8];
+
+static void collectReverse(IL *list, IN *node, int index) {
+  reverseValues[reverseCount++] = node->value * 10 + index;
+}
+
+// walks from the end use the node table instead of restarting from the start
+static void testBackwardWalks() {
+  IL *list = IL_createFrom((int []){4, 1, 4, 2, 4, 3}, 6);
+  CHECK(IL_lastIndexOf(list, 4) == 4);
+  CHECK(IL_lastIndexOf(list, 1) == 1);
+  CHECK(IL_lastIndexOf(list, 9) == -1);
+  reverseCount = 0;
+  IL_forEachReverse(list, collectReverse);
+  CHECK(reverseCount == 6 && reverseValues[0] == 35 && reverseValues[5] == 40);
+  CHECK(IL_pop(list) == 3 && IL_pop(list) == 4 && list->end->value == 2 && list->size == 4);
+  while(list->size > 0) {
+    IL_pop(list);
+  }
+  CHECK(list->start == NULL && list->end == NULL);
+  IL_add(list, 8);
+  CHECK(list->start == list->end && IL_lastIndexOf(list, 8) == 0);
+  IL_delete(list);
+
+  CL *chars = CL_createFrom("abcab");
+  CHECK(CL_pop(chars) == 'b' && CL_pop(chars) == 'a' && chars->end->value == 'c');
+  CL_delete(chars);
+  DL *doubles = DL_createFrom((double []){1.5, 2.5, 1.5}, 3);
+  CHECK(DL_lastIndexOf(doubles, 1.5) == 2 && DL_pop(doubles) == 1.5 && doubles->end->value == 2.5);
+  DL_delete(doubles);
+}
+
+int main() {
+  IL *list = IL_create();
+  testRandomEdits(list);
+  IL_delete(list);
+  list = IL_createPooled();
+  testRandomEdits(list);
+  IL_delete(list);
+  testStrings();
+  testBackwardWalks();
+  return TEST_RESULT();
+}
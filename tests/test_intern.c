@@ -0,0 +1,110 @@
+#include "test.h"
+
+#define LONG_WORD "a hostname that is long enough.example.com"
+
+static SN * nodeAt(SL *list, int index) {
+  SN *node = list->start;
+  while(index-- > 0) {
+    node = node->next;
+  }
+  return node;
+}
+
+// the counting allocator, made to fail on demand
+static bool isFailing = false;
+
+static void * failingAlloc(void *context, size_t size) {
+  return isFailing ? NULL : countingAlloc(context, size);
+}
+
+static void * failingRealloc(void *context, void *memory, size_t size) {
+  return isFailing ? NULL : countingRealloc(context, memory, size);
+}
+
+static const STF_Allocator failingAllocator = {failingAlloc, failingRealloc, countingFree, NULL};
+
+static void testSharing() {
+  size_t before = liveBytes;
+  STF_Intern *intern = STF_Intern_create(), *other = STF_Intern_create();
+  SL *list = SL_create(), *pooled = SL_createPooled(), *apart = SL_create();
+  CHECK(SL_enableInterning(list, intern) && SL_enableInterning(pooled, intern) && SL_enableInterning(apart, other));
+  for(int i = 0;i < 100;i++) {
+    SL_addArray(list, i % 2 == 0 ? "200" : LONG_WORD);
+    SL_addArray(pooled, LONG_WORD);
+    SL_addArray(apart, LONG_WORD);
+  }
+  // one buffer per string in a pool, another one in the other pool
+  CHECK(nodeChars(nodeAt(list, 1)) == nodeChars(nodeAt(pooled, 7)));
+  CHECK(nodeChars(nodeAt(list, 1)) != nodeChars(nodeAt(apart, 1)));
+  CHECK(intern->size == 2 && other->size == 1);
+  CHECK(SL_countArray(list, "200") == 50 && SL_indexOfArray(list, LONG_WORD) == 1 && SL_lastIndexOfArray(list, "200") == 98);
+  CHECK(SL_countArray(apart, LONG_WORD) == 100 && SL_indexOfArray(apart, "200") == -1);
+  CHECK(SL_replaceArray(list, "200", "500") && SL_countArray(list, "500") == 50 && SL_countArray(list, "200") == 0);
+  SL_toUpperCase(pooled);
+  CHECK(nodeAt(pooled, 3)->isInterned && SL_countArray(pooled, "A HOSTNAME THAT IS LONG ENOUGH.EXAMPLE.COM") == 100);
+  CHECK(SL_countArray(list, LONG_WORD) == 50);
+  SL_delete(list);
+  SL_delete(pooled);
+  SL_delete(apart);
+  CHECK(intern->size == 0 && other->size == 0);
+  STF_Intern_delete(intern);
+  STF_Intern_delete(other);
+  CHECK(liveBytes == before);
+}
+
+static void testSplice() {
+  size_t before = liveBytes;
+  STF_Intern *intern = STF_Intern_create(), *other = STF_Intern_create();
+  SL *plain = SL_create(), *interned = SL_create(), *apart = SL_create(), *pooled = SL_createPooled();
+  SL_enableInterning(interned, intern);
+  SL_enableInterning(apart, other);
+  SL_enableInterning(pooled, intern);
+  SL_addArray(plain, "plain");
+  for(int i = 0;i < 3;i++) {
+    SL_addArray(interned, LONG_WORD);
+    SL_addArray(apart, "apart");
+    SL_addArray(pooled, "pooled");
+  }
+  // moved nodes take the interning of the list they land in
+  CHECK(SL_concatMove(plain, interned) && plain->size == 4 && !nodeAt(plain, 2)->isInterned && intern->size == 1);
+  SL_toUpperCase(plain);
+  CHECK(SL_countArray(plain, "A HOSTNAME THAT IS LONG ENOUGH.EXAMPLE.COM") == 3);
+  SL_enableInterning(interned, intern);
+  CHECK(SL_spliceAt(interned, 0, plain) && nodeAt(interned, 0)->isInterned && intern->size == 3);
+  CHECK(SL_concatMove(interned, apart) && other->size == 0 && SL_countArray(interned, "apart") == 3);
+  CHECK(nodeChars(nodeAt(interned, 4)) == nodeChars(nodeAt(interned, 6)));
+  // nodes of another allocator are copied into the pool of the list
+  CHECK(SL_concatMove(interned, pooled) && SL_countArray(interned, "pooled") == 3 && intern->size == 4);
+  CHECK(SL_equals(interned, interned) && SL_indexOfArray(interned, "pooled") == 7);
+  SL_delete(plain);
+  SL_delete(interned);
+  SL_delete(apart);
+  SL_delete(pooled);
+  STF_Intern_delete(intern);
+  STF_Intern_delete(other);
+  CHECK(liveBytes == before);
+}
+
+// a pool that never got a string has no slots, looking it up must not probe them
+static void testEmptyPool() {
+  STF_Intern *intern = STF_Intern_create();
+  SL *list = SL_create();
+  SL_addArray(list, "x");
+  SL_addArray(list, LONG_WORD);
+  isFailing = true;
+  CHECK(!SL_enableInterning(list, intern));
+  isFailing = false;
+  CHECK(intern->size == 0 && intern->capacity == 0);
+  CHECK(SL_indexOfArray(list, LONG_WORD) == 1 && SL_countArray(list, "x") == 1 && SL_indexOfArray(list, "y") == -1);
+  CHECK(SL_replaceArray(list, "x", "y") && SL_indexOfArray(list, "y") == 0);
+  SL_delete(list);
+  STF_Intern_delete(intern);
+}
+
+int main() {
+  STF_setAllocator(&failingAllocator);
+  testSharing();
+  testSplice();
+  testEmptyPool();
+  return TEST_RESULT();
+}
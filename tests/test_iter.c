@@ -0,0 +1,98 @@
+#include "test.h"
+
+static int shadow[5000], length;
+
+static bool matchesShadow(IL *list) {
+  if(list->size != length || (length == 0 && (list->start != NULL || list->end != NULL))) {
+    return false;
+  }
+  IN *node = list->start;
+  for(int i = 0;i < length;i++) {
+    if(node->value != shadow[i] || IL_get(list, i) != shadow[i] || (i == length - 1 && list->end != node)) {
+      return false;
+    }
+    node = node->next;
+  }
+  return true;
+}
+
+// walk to a random position then insert after it, remove after it or set it
+static void testRandomWalks(IL *list) {
+  srand(3);
+  length = 0;
+  for(int round = 0;round < 300;round++) {
+    IL_Iter iter = IL_iterBegin(list);
+    int position = -1, steps = rand() % (length + 2);
+    for(int step = 0;step < steps;step++) {
+      if(!IL_iterNext(&iter)) {
+        position = length;
+        break;
+      }
+      position++;
+      CHECK(IL_iterValue(&iter) == shadow[position] && iter.index == position);
+    }
+    int op = rand() % 4;
+    if(position == length) {
+      CHECK(!IL_iterInsertAfter(&iter, 1) && !IL_iterRemoveNext(&iter));
+      continue;
+    }
+    if(op < 2) {
+      int v = rand();
+      CHECK(IL_iterInsertAfter(&iter, v));
+      memmove(shadow + position + 2, shadow + position + 1, (length - position - 1) * sizeof(int));
+      shadow[position + 1] = v;
+      length++;
+    }else if(op == 2) {
+      bool isRemoved = IL_iterRemoveNext(&iter);
+      CHECK(isRemoved == (position + 1 < length));
+      if(isRemoved) {
+        memmove(shadow + position + 1, shadow + position + 2, (length - position - 2) * sizeof(int));
+        length--;
+      }
+    }else if(position >= 0) {
+      IL_iterSet(&iter, 7);
+      shadow[position] = 7;
+    }
+    CHECK(matchesShadow(list));
+  }
+}
+
+static void testOtherTypes() {
+  SL *strings = SL_create();
+  SL_Iter iter = SL_iterBegin(strings);
+  CHECK(SL_iterInsertAfterArray(&iter, "b") && SL_iterInsertAfterArray(&iter, "a"));
+  CHECK(SL_iterNext(&iter) && strcmp(SL_iterValue(&iter), "a") == 0);
+  SL_iterSetArray(&iter, "A");
+  SL_iterInsertAfterArray(&iter, "m");
+  CHECK(SL_iterRemoveNext(&iter));
+  CHECK(SL_iterNext(&iter) && strcmp(SL_iterValue(&iter), "b") == 0);
+  CHECK(!SL_iterRemoveNext(&iter) && !SL_iterNext(&iter) && SL_iterValue(&iter) == NULL);
+  CHECK(strings->size == 2 && SL_endsWithArray(strings, "b"));
+  CHECK_STRING(SL_get(strings, 0), "A");
+  SL_delete(strings);
+
+  CL *chars = CL_createFrom("ac");
+  CL_Iter charIter = CL_iterBegin(chars);
+  CHECK(CL_iterNext(&charIter) && CL_iterInsertAfter(&charIter, 'b'));
+  CHECK(CL_iterNext(&charIter) && CL_iterValue(&charIter) == 'b');
+  CHECK(CL_iterRemoveNext(&charIter) && chars->end->value == 'b');
+  CHECK_STRING(CL_toCharArray(chars), "ab");
+  CL_delete(chars);
+
+  BL *bools = BL_create();
+  BL_Iter boolIter = BL_iterBegin(bools);
+  CHECK(BL_iterInsertAfter(&boolIter, true) && BL_iterNext(&boolIter) && BL_iterValue(&boolIter));
+  CHECK(BL_iterSet(&boolIter, false) && BL_get(bools, 0) == false);
+  BL_delete(bools);
+}
+
+int main() {
+  IL *list = IL_create();
+  testRandomWalks(list);
+  IL_delete(list);
+  list = IL_createPooled();
+  testRandomWalks(list);
+  IL_delete(list);
+  testOtherTypes();
+  return TEST_RESULT();
+}
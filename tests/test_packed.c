@@ -0,0 +1,172 @@
+#include "test.h"
+
+static bool isSame(BL *listA, BL *listB) {
+  if(listA->size != listB->size) {
+    return false;
+  }
+  for(int i = 0;i < listA->size;i++) {
+    if(BL_get(listA, i) != BL_get(listB, i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool isSearchedAlike(BL *packed, BL *unpacked) {
+  for(int v = 0;v < 2;v++) {
+    if(BL_count(packed, v) != BL_count(unpacked, v) || BL_indexOf(packed, v) != BL_indexOf(unpacked, v) ||
+      BL_lastIndexOf(packed, v) != BL_lastIndexOf(unpacked, v) || BL_contains(packed, v) != BL_contains(unpacked, v)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void flip(BL *list, BN *node, int index) {
+  node->value = !node->value;
+}
+
+static bool isOdd(BL *list, BN *node, int index) {
+  return index % 2 == 1;
+}
+
+static bool flipAndKeep(BL *list, BN *node, int index) {
+  node->value = !node->value;
+  return node->value;
+}
+
+// a packed list must answer like a list of nodes holding the same values
+static void testAgainstNodes() {
+  srand(3);
+  for(int round = 0;round < 200;round++) {
+    BL *packed = BL_createPacked(), *unpacked = BL_create();
+    int size = rand() % 300;
+    for(int i = 0;i < size;i++) {
+      bool v = rand() & 1;
+      BL_add(packed, v);
+      BL_add(unpacked, v);
+    }
+    CHECK(packed->isPacked && isSame(packed, unpacked) && isSearchedAlike(packed, unpacked));
+    CHECK(BL_compare(packed, unpacked) == 0 && BL_equalsList(unpacked, packed));
+    if(size > 0) {
+      CHECK(BL_startsWith(packed, true) == BL_startsWith(unpacked, true));
+      CHECK(BL_endsWith(packed, true) == BL_endsWith(unpacked, true));
+      CHECK(BL_pop(packed) == BL_pop(unpacked));
+    }
+    switch(rand() % 3) {
+      case 0: BL_fill(packed, true); BL_fill(unpacked, true); break;
+      case 1: BL_not(packed); BL_not(unpacked); break;
+      case 2: BL_sort(packed); BL_sort(unpacked); break;
+    }
+    CHECK(isSame(packed, unpacked) && isSearchedAlike(packed, unpacked));
+    BL_rsort(packed);
+    BL_rsort(unpacked);
+    CHECK(isSame(packed, unpacked));
+    BL *inverse = BL_copy(packed), *unpackedInverse = BL_copy(unpacked);
+    CHECK(inverse->isPacked && isSame(inverse, unpacked));
+    BL_not(inverse);
+    BL_not(unpackedInverse);
+    BL *result = BL_copy(packed), *unpackedResult = BL_copy(unpacked);
+    CHECK(BL_xor(result, inverse) && BL_xor(unpackedResult, unpackedInverse) && isSame(result, unpackedResult));
+    CHECK(BL_count(result, true) == result->size);
+    CHECK(BL_and(result, packed) && BL_and(unpackedResult, unpacked) && isSame(result, unpackedResult));
+    CHECK(BL_or(result, inverse) && BL_or(unpackedResult, inverse) && isSame(result, unpackedResult));
+    bool values[3] = {true, false, true};
+    BL_concatArray(packed, values, 3);
+    BL_concatArray(unpacked, values, 3);
+    CHECK(isSame(packed, unpacked));
+    BL *copy = BL_copy(packed);
+    BL_concatList(packed, unpacked);
+    BL_concatList(unpacked, copy);
+    CHECK(isSame(packed, unpacked) && packed->isPacked && !unpacked->isPacked);
+    BL_concatList(copy, copy);
+    CHECK(isSame(copy, packed));
+    BL_delete(copy);
+    BL_delete(inverse);
+    BL_delete(unpackedInverse);
+    BL_delete(result);
+    BL_delete(unpackedResult);
+    BL_delete(packed);
+    BL_delete(unpacked);
+  }
+}
+
+// reads and callbacks work on the bits and leave the list packed
+static void testStaysPacked() {
+  BL *list = BL_createPacked();
+  for(int i = 0;i < 130;i++) {
+    BL_add(list, i % 3 == 0);
+  }
+  BL *slice = BL_slice(list, 60, 75);
+  CHECK(slice != NULL && slice->isPacked && slice->size == 15 && BL_get(slice, 0) && BL_count(slice, true) == 5);
+  BL_delete(slice);
+  BL view = BL_view(list, 0, 10);
+  CHECK(view.size == 0 && list->isPacked);
+  BL_forEach(list, flip);
+  CHECK(list->isPacked && !BL_get(list, 0) && BL_get(list, 1) && BL_count(list, true) == 86);
+  BL_forEachReverse(list, flip);
+  CHECK(list->isPacked && BL_count(list, true) == 44);
+  BL *odd = BL_filter(list, isOdd);
+  CHECK(odd != NULL && odd->size == 65 && BL_count(odd, true) == 22 && list->isPacked);
+  BL_delete(odd);
+  CHECK(!BL_every(list, isOdd) && list->isPacked);
+  BL *mapped = BL_map(list, flipAndKeep);
+  CHECK(mapped != NULL && mapped->size == 130 && BL_count(mapped, true) == 86 && BL_count(list, true) == 86);
+  BL_delete(mapped);
+  BL_Iter iter = BL_iterBegin(list);
+  int count = 0, trueCount = 0;
+  while(BL_iterNext(&iter)) {
+    trueCount += BL_iterValue(&iter);
+    BL_iterSet(&iter, iter.index < 10);
+    count++;
+  }
+  CHECK(count == 130 && trueCount == 86 && list->isPacked && !BL_iterNext(&iter));
+  CHECK(BL_count(list, true) == 10 && BL_indexOf(list, false) == 10);
+  // relinking through the iterator unpacks the list and keeps its place
+  iter = BL_iterBegin(list);
+  BL_iterNext(&iter);
+  BL_iterNext(&iter);
+  CHECK(BL_iterInsertAfter(&iter, false) && !list->isPacked && iter.node != NULL && BL_iterValue(&iter));
+  CHECK(BL_iterNext(&iter) && !BL_iterValue(&iter) && list->size == 131 && BL_count(list, true) == 10);
+  CHECK(BL_iterRemoveNext(&iter) && list->size == 130 && BL_get(list, 3));
+  BL_delete(list);
+}
+
+static void testUnpackPaths() {
+  BL *list = BL_createPacked();
+  for(int i = 0;i < 100;i++) {
+    BL_add(list, i % 2 == 0);
+  }
+  BL_insert(list, true, 50);
+  CHECK(!list->isPacked && list->size == 101 && BL_get(list, 50));
+  CHECK(BL_pack(list) && list->isPacked && BL_get(list, 50) && BL_count(list, true) == 51);
+  BL_remove(list, 0);
+  CHECK(!list->isPacked && !BL_get(list, 0));
+  BL_pack(list);
+  BL_reverse(list);
+  CHECK(!list->isPacked && !BL_get(list, 99) && BL_get(list, 98));
+  BL_pack(list);
+  BL_clear(list);
+  CHECK(list->size == 0 && BL_indexOf(list, true) == -1);
+  BL_add(list, true);
+  CHECK(BL_count(list, true) == 1 && BL_count(list, false) == 0);
+  BL_delete(list);
+  BL *pooled = BL_createPooled();
+  for(int i = 0;i < 100;i++) {
+    BL_add(pooled, i % 3 == 0);
+  }
+  BL_get(pooled, 50);
+  CHECK(BL_pack(pooled) && BL_count(pooled, true) == 34 && BL_unpack(pooled) && BL_count(pooled, true) == 34 && BL_get(pooled, 99));
+  BL_delete(pooled);
+  BL *empty = BL_createPacked();
+  BL_fill(empty, true);
+  CHECK(BL_pop(empty) == false && BL_unpack(empty) && empty->size == 0);
+  BL_delete(empty);
+}
+
+int main() {
+  testAgainstNodes();
+  testStaysPacked();
+  testUnpackPaths();
+  return TEST_RESULT();
+}
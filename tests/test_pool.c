@@ -0,0 +1,68 @@
+#include "test.h"
+
+// pooled lists give removed nodes back to their pool and take them again first
+static void testNodeReuse() {
+  IL *list = IL_createPooled();
+  for(int i = 0;i < 1000;i++) {
+    IL_add(list, i);
+  }
+  IN *node = list->end;
+  IL_pop(list);
+  IL_add(list, 7);
+  CHECK(list->end == node);
+  CHECK(IL_get(list, 999) == 7);
+  IL_delete(list);
+}
+
+static void testPooledOperations() {
+  IL *list = IL_createPooled();
+  for(int i = 0;i < 100000;i++) {
+    IL_add(list, i);
+  }
+  for(int i = 0;i < 500;i++) {
+    IL_remove(list, 10);
+  }
+  for(int i = 0;i < 500;i++) {
+    IL_shift(list);
+  }
+  for(int i = 0;i < 1000;i++) {
+    IL_unshift(list, -i);
+  }
+  CHECK(list->size == 100000);
+  CHECK(IL_get(list, 0) == -999);
+  CHECK(IL_get(list, 1000) == 1000);
+  CHECK(IL_get(list, list->size - 1) == 99999);
+  IL_delete(list);
+
+  SL *strings = SL_createPooled();
+  for(int i = 0;i < 1000;i++) {
+    SL_addArray(strings, "abc");
+  }
+  SL_remove(strings, 3);
+  SL_pop(strings);
+  CHECK(strings->size == 998);
+  CHECK_STRING(SL_get(strings, 500), "abc");
+  SL_delete(strings);
+
+  CL *chars = CL_createPooled();
+  CL_concatArray(chars, "hello");
+  CHECK_STRING(CL_toCharArray(chars), "hello");
+  CL_delete(chars);
+
+  DL *doubles = DL_createPooled();
+  DL_add(doubles, 1.5);
+  CHECK(DL_pop(doubles) == 1.5 && doubles->size == 0);
+  DL_delete(doubles);
+
+  BL *bools = BL_createPooled();
+  BL_add(bools, true);
+  BL_insert(bools, false, 0);
+  CHECK(BL_get(bools, 0) == false && BL_get(bools, 1) == true);
+  BL_delete(bools);
+}
+
+int main() {
+  testNodeReuse();
+  testPooledOperations();
+  return TEST_RESULT();
+}
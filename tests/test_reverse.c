@@ -0,0 +1,75 @@
+#include "test.h"
+
+static int shadow[40], length;
+
+static bool matchesShadow(IL *list) {
+  if(list->size != length) {
+    return false;
+  }
+  IN *node = list->start;
+  for(int i = 0;i < length;i++) {
+    if(node->value != shadow[i] || IL_get(list, i) != shadow[i] || (i == length - 1 && list->end != node)) {
+      return false;
+    }
+    node = node->next;
+  }
+  return true;
+}
+
+static void reverseShadow(int start, int end) {
+  for(int a = start, b = end - 1;a < b;a++, b--) {
+    int value = shadow[a];
+    shadow[a] = shadow[b];
+    shadow[b] = value;
+  }
+}
+
+// random ranges of plain and pooled lists, with and without a node table
+static void testRanges() {
+  srand(9);
+  for(int round = 0;round < 200;round++) {
+    IL *list = round & 1 ? IL_create() : IL_createPooled();
+    length = rand() % 40;
+    for(int i = 0;i < length;i++) {
+      shadow[i] = rand() % 100;
+      IL_add(list, shadow[i]);
+    }
+    if(round % 3 == 0) {
+      IL_get(list, 0);
+    }
+    for(int k = 0;k < 10;k++) {
+      int start = length == 0 ? 0 : rand() % (length + 1);
+      int end = start + (length == start ? 0 : rand() % (length - start + 1));
+      CHECK(IL_reverseRange(list, start, end));
+      reverseShadow(start, end);
+      CHECK(matchesShadow(list));
+    }
+    IL_reverse(list);
+    reverseShadow(0, length);
+    CHECK(matchesShadow(list));
+    CHECK(!IL_reverseRange(list, -1, 1) && !IL_reverseRange(list, 0, length + 1));
+    IL_add(list, 1);
+    CHECK(list->end->value == 1);
+    IL_delete(list);
+  }
+}
+
+static void testOtherTypes() {
+  SL *strings = SL_createFrom((String []){"a", "b", "c", "d"}, 4);
+  SL_reverse(strings);
+  CHECK_STRING(SL_get(strings, 0), "d");
+  CHECK(SL_endsWithArray(strings, "a"));
+  CHECK(SL_reverseRange(strings, 1, 3));
+  CHECK_STRING(SL_get(strings, 1), "b");
+  SL_delete(strings);
+  CL *chars = CL_createFrom("abcde");
+  CL_reverse(chars);
+  CHECK(CL_equalsArray(chars, "edcba") && chars->end->value == 'a');
+  CL_delete(chars);
+}
+
+int main() {
+  testRanges();
+  testOtherTypes();
+  return TEST_RESULT();
+}
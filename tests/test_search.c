@@ -0,0 +1,94 @@
+#include "test.h"
+
+#define MAX_SIZE 40
+
+static int expectedIndexOf(int *values, int size, int v) {
+  for(int i = 0;i < size;i++) {
+    if(values[i] == v) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static int expectedCount(int *values, int size, int v) {
+  int n = 0;
+  for(int i = 0;i < size;i++) {
+    n += values[i] == v;
+  }
+  return n;
+}
+
+// every size around the four node rounds, walked and over the node table
+static void testIntegers() {
+  srand(17);
+  for(int round = 0;round < 400;round++) {
+    int size = round % MAX_SIZE, values[MAX_SIZE];
+    for(int i = 0;i < size;i++) {
+      values[i] = rand() % 6;
+    }
+    IL *list = round % 3 == 0 ? IL_createPooled() : IL_create();
+    for(int i = 0;i < size;i++) {
+      IL_add(list, values[i]);
+    }
+    list->isSorted = false;
+    if(round % 2 == 1 && size > 0) {
+      IL_get(list, 0);
+      CHECK(list->isIndexed);
+    }
+    for(int v = 0;v < 7;v++) {
+      CHECK(IL_indexOf(list, v) == expectedIndexOf(values, size, v));
+      CHECK(IL_count(list, v) == expectedCount(values, size, v));
+      CHECK(IL_contains(list, v) == (expectedCount(values, size, v) > 0));
+    }
+    if(size > 2) {
+      IL view = IL_view(list, 1, size - 1);
+      view.isSorted = false;
+      for(int v = 0;v < 7;v++) {
+        int index = expectedIndexOf(values + 1, size - 2, v);
+        CHECK(IL_indexOf(&view, v) == index);
+        CHECK(IL_count(&view, v) == expectedCount(values + 1, size - 2, v));
+      }
+    }
+    // values removed from the front leave an offset into the table
+    if(list->isIndexed && size > 5) {
+      IL_shift(list);
+      IL_shift(list);
+      for(int v = 0;v < 7;v++) {
+        CHECK(IL_indexOf(list, v) == expectedIndexOf(values + 2, size - 2, v));
+        CHECK(IL_count(list, v) == expectedCount(values + 2, size - 2, v));
+      }
+    }
+    IL_delete(list);
+  }
+}
+
+static void testOtherTypes() {
+  CL *chars = CL_createFrom("abracadabra");
+  CL_get(chars, 0);
+  CHECK(CL_count(chars, 'a') == 5 && CL_indexOf(chars, 'd') == 6 && CL_indexOf(chars, 'z') == -1);
+  CHECK(CL_contains(chars, 'c') && !CL_contains(chars, 'e'));
+  CL_delete(chars);
+  double values[] = {0.5, 2, 0.5, -1, 3, 0.5, 2};
+  DL *doubles = DL_createFrom(values, 7);
+  CHECK(DL_count(doubles, 0.5) == 3 && DL_indexOf(doubles, 3) == 4);
+  DL_get(doubles, 0);
+  CHECK(DL_count(doubles, 0.5) == 3 && DL_indexOf(doubles, 3) == 4 && DL_indexOf(doubles, 4) == -1);
+  DL_delete(doubles);
+  BL *bools = BL_create();
+  for(int i = 0;i < 23;i++) {
+    BL_add(bools, i % 3 == 2);
+  }
+  CHECK(BL_count(bools, true) == 7 && BL_indexOf(bools, true) == 2 && BL_contains(bools, false));
+  BL_get(bools, 0);
+  CHECK(BL_count(bools, true) == 7 && BL_count(bools, false) == 16 && BL_indexOf(bools, true) == 2);
+  BL_fill(bools, false);
+  CHECK(BL_indexOf(bools, true) == -1 && BL_count(bools, false) == 23);
+  BL_delete(bools);
+}
+
+int main() {
+  testIntegers();
+  testOtherTypes();
+  return TEST_RESULT();
+}
@@ -0,0 +1,103 @@
+#include "test.h"
+
+static bool containsValue(int *values, int count, int value) {
+  for(int i = 0;i < count;i++) {
+    if(values[i] == value) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// compare every operation with the quadratic version it replaces
+static void testIntegers() {
+  srand(4);
+  for(int round = 0;round < 300;round++) {
+    int countA = rand() % 50, countB = rand() % 50, a[50], b[50], range = rand() % 30 + 1;
+    for(int i = 0;i < countA;i++) {
+      a[i] = rand() % range - range / 2;
+    }
+    for(int i = 0;i < countB;i++) {
+      b[i] = rand() % range - range / 2;
+    }
+    IL *listA = IL_createFrom(a, countA), *listB = IL_createFrom(b, countB);
+    int expected[100], count = 0;
+    IL *result = IL_unique(listA);
+    for(int i = 0;i < countA;i++) {
+      if(!containsValue(expected, count, a[i])) {
+        expected[count++] = a[i];
+      }
+    }
+    CHECK(IL_equalsArray(result, expected, count));
+    IL_delete(result);
+    result = IL_intersect(listA, listB);
+    count = 0;
+    for(int i = 0;i < countA;i++) {
+      if(containsValue(b, countB, a[i]) && !containsValue(expected, count, a[i])) {
+        expected[count++] = a[i];
+      }
+    }
+    CHECK(IL_equalsArray(result, expected, count));
+    IL_delete(result);
+    result = IL_difference(listA, listB);
+    count = 0;
+    for(int i = 0;i < countA;i++) {
+      if(!containsValue(b, countB, a[i]) && !containsValue(expected, count, a[i])) {
+        expected[count++] = a[i];
+      }
+    }
+    CHECK(IL_equalsArray(result, expected, count));
+    IL_delete(result);
+    result = IL_union(listA, listB);
+    count = 0;
+    for(int i = 0;i < countA + countB;i++) {
+      int value = i < countA ? a[i] : b[i - countA];
+      if(!containsValue(expected, count, value)) {
+        expected[count++] = value;
+      }
+    }
+    CHECK(IL_equalsArray(result, expected, count));
+    IL_delete(result);
+    IL_delete(listA);
+    IL_delete(listB);
+  }
+}
+
+static void checkStrings(SL *list, String *expected, int count) {
+  SL *expectedList = SL_createFrom(expected, count);
+  CHECK(SL_equals(list, expectedList));
+  SL_delete(expectedList);
+  SL_delete(list);
+}
+
+static void testStrings() {
+  String a[] = {"a", "b", "a", "", "c", "b", "a word too long for the short buffer", "b"};
+  String b[] = {"b", "", "z", "a word too long for the short buffer"};
+  SL *listA = SL_createFrom(a, 8), *listB = SL_createFrom(b, 4);
+  String unique[] = {"a", "b", "", "c", "a word too long for the short buffer"};
+  checkStrings(SL_unique(listA), unique, 5);
+  String intersection[] = {"b", "", "a word too long for the short buffer"};
+  checkStrings(SL_intersect(listA, listB), intersection, 3);
+  // listB's own index is used as the filter
+  SL_enableHash(listB);
+  checkStrings(SL_intersect(listA, listB), intersection, 3);
+  String difference[] = {"a", "c"};
+  checkStrings(SL_difference(listA, listB), difference, 2);
+  SL_disableHash(listB);
+  checkStrings(SL_difference(listA, listB), difference, 2);
+  String both[] = {"a", "b", "", "c", "a word too long for the short buffer", "z"};
+  checkStrings(SL_union(listA, listB), both, 6);
+  SL *empty = SL_create();
+  checkStrings(SL_intersect(listA, empty), NULL, 0);
+  checkStrings(SL_difference(empty, listA), NULL, 0);
+  checkStrings(SL_union(empty, listB), b, 4);
+  SL_delete(empty);
+  SL_delete(listA);
+  SL_delete(listB);
+}
+
+int main() {
+  testIntegers();
+  testStrings();
+  return TEST_RESULT();
+}
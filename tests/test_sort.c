@@ -0,0 +1,179 @@
+#include "test.h"
+
+static int ascendingInts(const void *a, const void *b) {
+  int x = *(const int *)a, y = *(const int *)b;
+  return x < y ? -1 : x > y;
+}
+
+static int ascendingDoubles(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return x < y ? -1 : x > y;
+}
+
+static int ascendingChars(const void *a, const void *b) {
+  return *(const char *)a - *(const char *)b;
+}
+
+// sizes around the cutoff where the sorts switch from comparisons to counting
+static const int sizes[] = {0, 1, 2, 3, 63, 64, 65, 1000, 5000};
+
+static void testNumbers() {
+  srand(3);
+  for(int s = 0;s < (int)(sizeof(sizes) / sizeof(sizes[0]));s++) {
+    for(int isReversed = 0;isReversed < 2;isReversed++) {
+      int n = sizes[s];
+      int *ints = (int *)malloc((n + 1) * sizeof(int));
+      double *doubles = (double *)malloc((n + 1) * sizeof(double));
+      for(int i = 0;i < n;i++) {
+        ints[i] = i % 7 == 0 ? INT_MIN + rand() % 3 : i % 11 == 0 ? INT_MAX - rand() % 3 : rand() - RAND_MAX / 2;
+        doubles[i] = (rand() % 2000 - 1000) / 8.0;
+      }
+      IL *intList = IL_createFrom(ints, n);
+      DL *doubleList = DL_createFrom(doubles, n);
+      (isReversed ? IL_rsort : IL_sort)(intList);
+      (isReversed ? DL_rsort : DL_sort)(doubleList);
+      qsort(ints, n, sizeof(int), ascendingInts);
+      qsort(doubles, n, sizeof(double), ascendingDoubles);
+      bool isOrdered = intList->size == n && doubleList->size == n;
+      IN *intNode = intList->start;
+      DN *doubleNode = doubleList->start;
+      for(int i = 0;i < n && isOrdered;i++) {
+        int j = isReversed ? n - 1 - i : i;
+        isOrdered = intNode->value == ints[j] && doubleNode->value == doubles[j];
+        intNode = intNode->next;
+        doubleNode = doubleNode->next;
+      }
+      CHECK(isOrdered);
+      if(n > 0) {
+        CHECK(IL_get(intList, n - 1) == ints[isReversed ? 0 : n - 1]);
+        CHECK(IL_add(intList, 5) && IL_get(intList, n) == 5 && intList->end->value == 5);
+      }
+      IL_delete(intList);
+      DL_delete(doubleList);
+      free(ints);
+      free(doubles);
+    }
+  }
+}
+
+static void testCharsAndBools() {
+  srand(5);
+  for(int s = 0;s < (int)(sizeof(sizes) / sizeof(sizes[0]));s++) {
+    for(int isReversed = 0;isReversed < 2;isReversed++) {
+      int n = sizes[s], trueCount = 0;
+      char *chars = (char *)malloc(n + 1);
+      bool *bools = (bool *)malloc(n + 1);
+      for(int i = 0;i < n;i++) {
+        chars[i] = (char)(rand() % 255 + 1);
+        bools[i] = rand() & 1;
+        trueCount += bools[i];
+      }
+      chars[n] = '\0';
+      CL *charList = CL_createFrom(chars);
+      BL *boolList = BL_createFrom(bools, n);
+      (isReversed ? CL_rsort : CL_sort)(charList);
+      (isReversed ? BL_rsort : BL_sort)(boolList);
+      qsort(chars, n, 1, ascendingChars);
+      bool isOrdered = charList->size == n && boolList->size == n;
+      for(int i = 0;i < n && isOrdered;i++) {
+        isOrdered = CL_get(charList, i) == chars[isReversed ? n - 1 - i : i] &&
+          BL_get(boolList, i) == (isReversed ? i < trueCount : i >= n - trueCount);
+      }
+      CHECK(isOrdered);
+      CL_delete(charList);
+      BL_delete(boolList);
+      free(chars);
+      free(bools);
+    }
+  }
+}
+
+// the radix sort goes through every byte, the sign included
+static void testRadixEdges() {
+  int n = 3000;
+  int *ints = (int *)malloc(n * sizeof(int));
+  for(int i = 0;i < n;i++) {
+    ints[i] = (i % 4 == 0 ? -1 : 1) * (int)((unsigned)(n - i) * 2654435761u >> 1);
+  }
+  IL *list = IL_createFrom(ints, n);
+  IL_sort(list);
+  qsort(ints, n, sizeof(int), ascendingInts);
+  CHECK(IL_equalsArray(list, ints, n));
+  IL_sort(list);
+  CHECK(IL_equalsArray(list, ints, n));
+  IL_fill(list, -42);
+  IL_rsort(list);
+  CHECK(IL_count(list, -42) == n && list->end->value == -42);
+  IL_delete(list);
+  free(ints);
+
+  CL *chars = CL_create();
+  for(int i = 0;i < 1000;i++) {
+    CL_add(chars, (char)(i * 7));
+  }
+  CL_sort(chars);
+  bool isOrdered = true;
+  for(CN *node = chars->start;node->next != NULL;node = node->next) {
+    isOrdered = isOrdered && node->value <= node->next->value;
+  }
+  CHECK(isOrdered && CL_get(chars, 0) == CHAR_MIN && CL_get(chars, 999) == CHAR_MAX);
+  CL_delete(chars);
+}
+
+// SL orders strings by signed chars, a prefix coming before the longer string
+static int ascendingStrings(const void *a, const void *b) {
+  const char *x = *(char * const *)a, *y = *(char * const *)b;
+  while(*x != '\0' && *x == *y) {
+    x++;
+    y++;
+  }
+  return *x == *y ? 0 : *x == '\0' ? -1 : *y == '\0' ? 1 : (signed char)*x < (signed char)*y ? -1 : 1;
+}
+
+static void testStrings() {
+  srand(9);
+  static const int stringSizes[] = {0, 1, 2, 5, 9, 10, 11, 50, 2000};
+  for(int s = 0;s < (int)(sizeof(stringSizes) / sizeof(stringSizes[0]));s++) {
+    for(int isReversed = 0;isReversed < 2;isReversed++) {
+      int n = stringSizes[s];
+      String *strings = (String *)malloc((n + 1) * sizeof(String));
+      for(int i = 0;i < n;i++) {
+        int length = rand() % 6;
+        strings[i] = (String)malloc(length + 1);
+        for(int j = 0;j < length;j++) {
+          strings[i][j] = "abAB\xe9z"[rand() % 6];
+        }
+        strings[i][length] = '\0';
+      }
+      SL *list = SL_createFrom(strings, n);
+      (isReversed ? SL_rsort : SL_sort)(list);
+      qsort(strings, n, sizeof(String), ascendingStrings);
+      bool isOrdered = list->size == n;
+      SN *node = list->start;
+      for(int i = 0;i < n && isOrdered;i++) {
+        String expected = strings[isReversed ? n - 1 - i : i];
+        isOrdered = node->length == (int)strlen(expected) && memcmp(nodeChars(node), expected, node->length) == 0;
+        node = node->next;
+      }
+      CHECK(isOrdered);
+      if(n > 0) {
+        CHECK_STRING(SL_get(list, n - 1), strings[isReversed ? 0 : n - 1]);
+        SL_addArray(list, "end");
+        CHECK(SL_endsWithArray(list, "end"));
+      }
+      SL_delete(list);
+      for(int i = 0;i < n;i++) {
+        free(strings[i]);
+      }
+      free(strings);
+    }
+  }
+}
+
+int main() {
+  testNumbers();
+  testCharsAndBools();
+  testRadixEdges();
+  testStrings();
+  return TEST_RESULT();
+}
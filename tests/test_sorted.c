@@ -0,0 +1,176 @@
+#include "test.h"
+
+static bool isInOrder(IL *list) {
+  IN *node = list->start;
+  for(int i = 1;i < list->size;i++) {
+    if(node->value > node->next->value) {
+      return false;
+    }
+    node = node->next;
+  }
+  return true;
+}
+
+static int linearIndexOf(IL *list, int v, bool isLast) {
+  int index = -1;
+  IN *node = list->start;
+  for(int i = 0;i < list->size;i++) {
+    if(node->value == v) {
+      index = i;
+      if(!isLast) {
+        return i;
+      }
+    }
+    node = node->next;
+  }
+  return index;
+}
+
+static int linearCount(IL *list, int v) {
+  int count = 0;
+  IN *node = list->start;
+  for(int i = 0;i < list->size;i++) {
+    count += node->value == v;
+    node = node->next;
+  }
+  return count;
+}
+
+// the flag must never claim an unsorted list and the searches must agree with a linear walk
+static void testIntegers() {
+  srand(21);
+  int sortedSteps = 0;
+  for(int round = 0;round < 100;round++) {
+    IL *list = round % 2 == 0 ? IL_create() : IL_createPooled();
+    for(int step = 0;step < 300;step++) {
+      int v = rand() % 20, index = list->size == 0 ? 0 : rand() % list->size;
+      switch(rand() % 12) {
+        case 0: IL_add(list, v); break;
+        case 1: IL_unshift(list, v); break;
+        case 2: IL_insert(list, v, index); break;
+        case 3: IL_remove(list, index); break;
+        case 4:
+          if(rand() % 5 == 0) {
+            IL_sort(list);
+          }
+          break;
+        case 5: IL_sortedInsert(list, v); break;
+        case 6: IL_pop(list); break;
+        case 7: IL_shift(list); break;
+        case 8:
+          if(rand() % 10 == 0) {
+            IL_reverseRange(list, 0, list->size / 2);
+          }
+          break;
+        case 9: {
+          int values[3] = {v, v + 1, v + 2};
+          IL_concatArray(list, values, 3);
+          break;
+        }
+        case 10:
+          if(rand() % 10 == 0) {
+            IL_set(list, v, index);
+          }
+          break;
+        case 11:
+          if(rand() % 20 == 0) {
+            IL_fill(list, v);
+          }
+          break;
+      }
+      CHECK(!list->isSorted || isInOrder(list));
+      int query = rand() % 22, count = linearCount(list, query);
+      CHECK(IL_indexOf(list, query) == linearIndexOf(list, query, false));
+      CHECK(IL_lastIndexOf(list, query) == linearIndexOf(list, query, true));
+      CHECK(IL_count(list, query) == count);
+      CHECK(IL_contains(list, query) == (count > 0));
+      if(list->isSorted) {
+        sortedSteps++;
+        int lower = IL_lowerBound(list, query), upper = IL_upperBound(list, query);
+        CHECK(IL_binarySearch(list, query) == linearIndexOf(list, query, false));
+        CHECK(upper - lower == count);
+        CHECK(lower == list->size || IL_get(list, lower) >= query);
+        CHECK(lower == 0 || IL_get(list, lower - 1) < query);
+        IL view = IL_view(list, 0, list->size);
+        CHECK(view.isSorted && IL_count(&view, query) == count);
+      }
+    }
+    IL_delete(list);
+  }
+  CHECK(sortedSteps > 0);
+}
+
+static void testStrings() {
+  String words[] = {"b", "a", "", "ab", "c", "bb", "B"};
+  for(int round = 0;round < 50;round++) {
+    SL *list = SL_create();
+    if(round % 2 == 1) {
+      SL_enableHash(list);
+    }
+    for(int step = 0;step < 200;step++) {
+      String word = words[rand() % 7];
+      int index = list->size == 0 ? 0 : rand() % list->size;
+      switch(rand() % 7) {
+        case 0: SL_addArray(list, word); break;
+        case 1: SL_unshiftArray(list, word); break;
+        case 2: SL_insertArray(list, word, index); break;
+        case 3: SL_remove(list, index); break;
+        case 4:
+          if(rand() % 5 == 0) {
+            SL_sort(list);
+          }
+          break;
+        case 5: SL_sortedInsert(list, word); break;
+        case 6:
+          if(rand() % 5 == 0) {
+            SL_toUpperCase(list);
+          }
+          break;
+      }
+      String query = words[rand() % 7];
+      int first = -1, last = -1, count = 0;
+      bool isInOrder = true;
+      SN *node = list->start, *previous = NULL;
+      for(int i = 0;i < list->size;i++) {
+        if(strcmp(nodeChars(node), query) == 0) {
+          first = first < 0 ? i : first;
+          last = i;
+          count++;
+        }
+        isInOrder = isInOrder && (previous == NULL || strcmp(nodeChars(previous), nodeChars(node)) <= 0);
+        previous = node;
+        node = node->next;
+      }
+      CHECK(!list->isSorted || isInOrder);
+      CHECK(SL_indexOfArray(list, query) == first);
+      CHECK(SL_lastIndexOfArray(list, query) == last);
+      CHECK(SL_countArray(list, query) == count);
+      CHECK(SL_containsArray(list, query) == (count > 0));
+      CHECK(!list->isSorted || SL_binarySearch(list, query) == first);
+    }
+    SL_delete(list);
+  }
+}
+
+static void testOtherTypes() {
+  double values[] = {3, 1, 2};
+  DL *doubles = DL_createFrom(values, 3);
+  CHECK(!doubles->isSorted);
+  DL_sort(doubles);
+  CHECK(doubles->isSorted && DL_binarySearch(doubles, 2) == 1 && DL_lowerBound(doubles, 2.5) == 2);
+  CHECK(DL_sortedInsert(doubles, 2.5) && DL_get(doubles, 2) == 2.5 && doubles->isSorted);
+  DL_delete(doubles);
+  CL *chars = CL_createFrom("dcba");
+  CL_sort(chars);
+  CHECK(CL_indexOf(chars, 'c') == 2 && CL_count(chars, 'z') == 0 && CL_upperBound(chars, 'b') == 2);
+  CL_toUpperCase(chars);
+  CHECK(!chars->isSorted);
+  CL_delete(chars);
+}
+
+int main() {
+  testIntegers();
+  testStrings();
+  testOtherTypes();
+  return TEST_RESULT();
+}
@@ -0,0 +1,121 @@
+#include "test.h"
+
+static int shadow[100000], length;
+
+static IL * createKind(int kind) {
+  return kind == 0 ? IL_create() : IL_createPooled();
+}
+
+static bool matchesShadow(IL *list) {
+  if(list->size != length || (length > 0 && list->end->next != NULL)) {
+    return false;
+  }
+  IN *node = list->start;
+  for(int i = 0;i < length;i++) {
+    if(node->value != shadow[i] || (i == length - 1 && list->end != node)) {
+      return false;
+    }
+    node = node->next;
+  }
+  for(int i = 0;i < length;i += 7) {
+    if(IL_get(list, i) != shadow[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// splice plain, pooled and copied lists at random places of plain and pooled lists
+static void testRandomSplices() {
+  srand(5);
+  for(int kind = 0;kind < 2;kind++) {
+    IL *list = createKind(kind);
+    length = 0;
+    for(int round = 0;round < 300;round++) {
+      int otherKind = rand() % 3;
+      IL *other = otherKind == 2 ? IL_copy(list) : createKind(otherKind);
+      if(otherKind == 2) {
+        IL_clear(other);
+      }
+      for(int i = rand() % 20;i > 0;i--) {
+        IL_add(other, round * 100 + i);
+      }
+      int values[40], count = other->size;
+      for(int i = 0;i < count;i++) {
+        values[i] = IL_get(other, i);
+      }
+      int index = length == 0 || rand() % 3 == 0 ? length : rand() % (length + 1);
+      CHECK(IL_spliceAt(list, index, other));
+      CHECK(other->size == 0 && other->start == NULL && other->end == NULL);
+      memmove(shadow + index + count, shadow + index, (length - index) * sizeof(int));
+      memcpy(shadow + index, values, count * sizeof(int));
+      length += count;
+      CHECK(matchesShadow(list));
+      IL_add(other, 1);
+      IL_delete(other);
+    }
+    CHECK(!IL_spliceAt(list, length + 1, list));
+    CHECK(!IL_concatListMove(list, list));
+    IL_delete(list);
+  }
+}
+
+// views and copied headers borrow nodes, moving them would leave their owner pointing at freed nodes
+static void testBorrowedNodes() {
+  for(int kind = 0;kind < 2;kind++) {
+    IL *a = createKind(kind), *b = createKind(kind);
+    for(int i = 0;i < 5;i++) {
+      IL_add(a, i);
+      IL_add(b, 10 + i);
+    }
+    IL viewB = IL_view(b, 1, 3);
+    CHECK(!IL_spliceAt(a, 2, &viewB));
+    CHECK(!IL_concatListMove(a, &viewB));
+    IL viewA = IL_view(a, 1, 3);
+    CHECK(!IL_spliceAt(a, 0, &viewA));
+    CHECK(!IL_spliceAt(&viewA, 0, b));
+    IL header = *a;
+    CHECK(!IL_spliceAt(a, 0, &header));
+    CHECK(a->size == 5 && b->size == 5 && IL_get(a, 4) == 4 && IL_get(b, 4) == 14);
+    IL_clear(a);
+    IL_clear(b);
+    IL_delete(a);
+    IL_delete(b);
+  }
+
+  SL *strings = SL_createFrom((String []){"a", "b", "c"}, 3);
+  SL view = SL_view(strings, 0, 2);
+  CHECK(!SL_spliceAt(strings, 1, &view) && !SL_concatMove(strings, &view));
+  BL *bools = BL_createFrom((bool []){true, false}, 2), *others = BL_create();
+  BL_add(others, true);
+  BL boolView = BL_view(others, 0, 1);
+  CHECK(!BL_spliceAt(bools, 0, &boolView) && bools->size == 2);
+  CL *chars = CL_createFrom("abc");
+  CL charView = CL_view(chars, 0, 1);
+  CHECK(!CL_concatListMove(chars, &charView));
+  DL *doubles = DL_createFrom((double []){1, 2}, 2);
+  DL doubleView = DL_view(doubles, 1, 2);
+  CHECK(!DL_spliceAt(doubles, 0, &doubleView));
+  SL_delete(strings);
+  BL_delete(bools);
+  BL_delete(others);
+  CL_delete(chars);
+  DL_delete(doubles);
+}
+
+static void testStrings() {
+  SL *a = SL_create(), *b = SL_createPooled();
+  SL_addArray(a, "x");
+  SL_addArray(b, "y");
+  CHECK(SL_concatMove(a, b));
+  CHECK(a->size == 2 && b->size == 0 && SL_endsWithArray(a, "y"));
+  SL_delete(b);
+  SL_delete(a);
+}
+
+int main() {
+  testRandomSplices();
+  testBorrowedNodes();
+  testStrings();
+  return TEST_RESULT();
+}
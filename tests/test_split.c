@@ -0,0 +1,28 @@
+#include "test.h"
+
+static bool splitsInto(String chars, String sep, String *expected, int count) {
+  CL *charList = CL_createFrom(chars);
+  SL *list = CL_split(charList, sep);
+  bool isEqual = list != NULL && list->size == count;
+  for(int i = 0;i < count && isEqual;i++) {
+    String piece = SL_get(list, i);
+    isEqual = piece != NULL && strcmp(piece, expected[i]) == 0;
+    STF_free(piece);
+  }
+  SL_delete(list);
+  CL_delete(charList);
+  return isEqual;
+}
+
+int main() {
+  CHECK(splitsInto("a,b,,c", ",", (String []){"a", "b", "", "c"}, 4));
+  CHECK(splitsInto("x--y--", "--", (String []){"x", "y", ""}, 3));
+  CHECK(splitsInto("::", "::", (String []){"", ""}, 2));
+  CHECK(splitsInto("a:::b", "::", (String []){"a", ":b"}, 2));
+  CHECK(splitsInto("aab", "ab", (String []){"a", ""}, 2));
+  CHECK(splitsInto("ab", "abc", (String []){"ab"}, 1));
+  CHECK(splitsInto("abc", "", (String []){"abc"}, 1));
+  CHECK(splitsInto("", ",", (String []){""}, 1));
+  CHECK(splitsInto("a piece longer than the short buffer,b", ",", (String []){"a piece longer than the short buffer", "b"}, 2));
+  return TEST_RESULT();
+}
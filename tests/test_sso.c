@@ -0,0 +1,70 @@
+#include "test.h"
+
+static String words[] = {"", "short", "exactly23chars_________", "exactly24chars__________", "a much longer string that goes to the heap"};
+
+static void appendX(SL *list, SN *node, int index) {
+  CL_toUpperCase(node->value);
+  CL_add(node->value, 'x');
+}
+
+static bool isStoredBySize(SL *list) {
+  for(SN *node = list->start;node != NULL;node = node->next) {
+    if(node->isShort != (!node->isInterned && node->length < STF_SHORT_LENGTH)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// short strings live in the node, longer ones on the heap, and moving between the two keeps the chars
+static void testStorage(bool isPooled) {
+  SL *list = isPooled ? SL_createPooled() : SL_create();
+  for(int i = 0;i < 5;i++) {
+    SL_addArray(list, words[i]);
+  }
+  for(int i = 0;i < 5;i++) {
+    CHECK_STRING(SL_get(list, i), words[i]);
+    CHECK(SL_indexOfArray(list, words[i]) == i);
+  }
+  SN *node = list->start->next;
+  CHECK(node->isShort && node->next->isShort && !node->next->next->isShort);
+  CHECK(isStoredBySize(list));
+  SL_setArray(list, "now this one is long enough to spill out", 1);
+  SL_setArray(list, "tiny", 4);
+  CHECK(list->end->isShort && !list->start->next->isShort && isStoredBySize(list));
+  CHECK_STRING(SL_get(list, 1), "now this one is long enough to spill out");
+  SL_toUpperCase(list);
+  CHECK_STRING(SL_get(list, 4), "TINY");
+  // a callback can grow a short string past the buffer
+  SL_forEach(list, appendX);
+  CHECK_STRING(SL_get(list, 2), "EXACTLY23CHARS_________x");
+  CHECK_STRING(SL_get(list, 4), "TINYx");
+  CHECK(isStoredBySize(list));
+  SL_sort(list);
+  for(int i = 1;i < 5;i++) {
+    String previous = SL_get(list, i - 1), next = SL_get(list, i);
+    CHECK(strcmp(previous, next) <= 0);
+    STF_free(previous);
+    STF_free(next);
+  }
+  CHECK(SL_compact(list) && isStoredBySize(list));
+  CHECK_STRING(SL_get(list, 3), "TINYx");
+  SL_enableHash(list);
+  CHECK(SL_containsArray(list, "TINYx") && SL_containsArray(list, "EXACTLY24CHARS__________x"));
+  SL *copy = SL_copy(list);
+  CHECK(SL_equals(copy, list) && isStoredBySize(copy));
+  SL_delete(copy);
+  SL_delete(list);
+}
+
+static void testSize() {
+  // the short buffer shares its place with the heap pointer
+  CHECK(STF_SHORT_LENGTH == 24 && sizeof(SN) <= 2 * sizeof(void *) + STF_SHORT_LENGTH + sizeof(double));
+}
+
+int main() {
+  testStorage(false);
+  testStorage(true);
+  testSize();
+  return TEST_RESULT();
+}
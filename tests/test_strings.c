@@ -0,0 +1,62 @@
+#include "test.h"
+
+static void exclaim(SL *list, SN *node, int index) {
+  CL_add(node->value, '!');
+}
+
+static CL * same(SL *list, SN *node, int index) {
+  return node->value;
+}
+
+static bool isLong(SL *list, SN *node, int index) {
+  return node->value->size > 3;
+}
+
+// strings are flat buffers that callbacks see as a charList for the length of the call
+static void testCallbacks() {
+  SL *list = SL_create();
+  SL_addArray(list, "ab");
+  SL_addArray(list, "");
+  SL_addArray(list, "xyz");
+  SL_forEach(list, exclaim);
+  SL_forEachReverse(list, exclaim);
+  CHECK_STRING(SL_get(list, 0), "ab!!");
+  CHECK_STRING(SL_get(list, 1), "!!");
+  CHECK(list->end->length == 5 && list->end->value == NULL);
+
+  SL *mapped = SL_map(list, same);
+  CHECK(SL_equals(list, mapped));
+  SL *filtered = SL_filter(list, isLong);
+  CHECK(filtered->size == 2 && SL_startsWithArray(filtered, "ab!!") && SL_endsWithArray(filtered, "xyz!!"));
+
+  SL_reverse(mapped);
+  CHECK_STRING(SL_get(mapped, 0), "xyz!!");
+  SL_toUpperCase(mapped);
+  CHECK(SL_indexOfArray(mapped, "XYZ!!") == 0);
+  SL_sort(mapped);
+  CHECK(SL_indexOfArray(mapped, "!!") == 0);
+  SL_replaceArray(mapped, "!!", "q");
+  CHECK(SL_countArray(mapped, "q") == 1);
+  SL_fillArray(mapped, "z");
+  CHECK(SL_countArray(mapped, "z") == 3);
+  SL_delete(filtered);
+  SL_delete(mapped);
+  SL_delete(list);
+}
+
+static void testSetList() {
+  SL *list = SL_createFrom((String []){"one", "two"}, 2);
+  CL *chars = CL_createFrom("a string long enough to go to the heap");
+  CHECK(SL_setList(list, chars, 0));
+  CHECK_STRING(SL_get(list, 0), "a string long enough to go to the heap");
+  CHECK(SL_indexOfList(list, chars) == 0);
+  CHECK(SL_addList(list, chars) && SL_countList(list, chars) == 2);
+  CL_delete(chars);
+  SL_delete(list);
+}
+
+int main() {
+  testCallbacks();
+  testSetList();
+  return TEST_RESULT();
+}
@@ -0,0 +1,59 @@
+#include "test.h"
+
+static void testReads() {
+  IL *list = IL_createFrom((int []){1, 2, 3, 2, 5, 6, 2}, 7);
+  IL view = IL_view(list, 1, 5);
+  CHECK(view.size == 4 && view.isView && IL_get(&view, 0) == 2 && IL_get(&view, 3) == 5);
+  CHECK(IL_indexOf(&view, 3) == 1 && IL_lastIndexOf(&view, 2) == 2 && IL_count(&view, 2) == 2);
+  CHECK(IL_contains(&view, 5) && !IL_contains(&view, 6));
+  CHECK(IL_equalsArray(&view, (int []){2, 3, 2, 5}, 4));
+  IL *copy = IL_copy(&view);
+  CHECK(IL_equalsList(copy, &view) && !copy->isView);
+  IL_delete(copy);
+
+  // a view of a view and views of lists without a node table
+  IL *plain = IL_create();
+  for(int i = 0;i < 7;i++) {
+    IL_add(plain, i * 10);
+  }
+  IL outer = IL_view(plain, 2, 7);
+  IL inner = IL_view(&outer, 1, 3);
+  CHECK(inner.size == 2 && IL_get(&inner, 0) == 30 && IL_get(&inner, 1) == 40);
+  CHECK(IL_view(plain, 3, 3).size == 0 && IL_view(plain, 0, 9).size == 0);
+  IL *slice = IL_slice(plain, 5, 100);
+  CHECK(slice->size == 2 && slice->end->value == 60);
+  IL_delete(slice);
+  slice = IL_sub(plain, 6, 5);
+  CHECK(slice->size == 1 && slice->start->value == 60);
+  IL_delete(slice);
+  CHECK(IL_slice(plain, 7, 8) == NULL);
+  IL_delete(list);
+  IL_delete(plain);
+}
+
+// a view never owns its nodes, the list keeps them whatever is done to the view
+static void testOwnership() {
+  IL *list = IL_createFrom((int []){1, 2, 3, 4}, 4);
+  IL view = IL_view(list, 1, 3);
+  CHECK(!IL_compact(&view));
+  IL_clear(&view);
+  CHECK(view.size == 0 && list->size == 4 && IL_get(list, 2) == 3);
+  IL_delete(list);
+
+  CL *chars = CL_createFrom("hello world");
+  CL charView = CL_view(chars, 6, 11);
+  CHECK(CL_equalsArray(&charView, "world"));
+  CHECK_STRING(CL_toCharArray(&charView), "world");
+  CL_delete(chars);
+
+  SL *strings = SL_createFrom((String []){"a", "b", "c"}, 3);
+  SL stringView = SL_view(strings, 1, 3);
+  CHECK(SL_indexOfArray(&stringView, "c") == 1 && SL_indexOfArray(&stringView, "a") == -1);
+  SL_delete(strings);
+}
+
+int main() {
+  testReads();
+  testOwnership();
+  return TEST_RESULT();
+}